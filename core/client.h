@@ -10,10 +10,15 @@
 #ifndef YCSB_C_CLIENT_H_
 #define YCSB_C_CLIENT_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <string>
 
-#include "db.h"
+#include "db_wrapper.h"
 #include "core_workload.h"
 #include "utils/countdown_latch.h"
 #include "utils/rate_limit.h"
@@ -21,28 +26,171 @@
 
 namespace ycsbc {
 
-inline int ClientThread(ycsbc::DB *db, ycsbc::Workload *wl, const int num_ops, bool is_loading,
-                        bool init_db, bool cleanup_db, utils::CountDownLatch *latch, utils::RateLimiter *rlim) {
+///
+/// Time bounds of a run shared by all its client threads.
+/// Operations issued during the warmup or the cooldown are executed but not
+/// measured, and every thread stops at the deadline with operations left.
+/// The threads record the span of their measured operations in measure_begin
+/// and measure_end, so the steady-state throughput can be derived.
+///
+struct RunLimits {
+  using Clock = std::chrono::steady_clock;
+
+  RunLimits(Clock::time_point start, double warmup_sec, int warmup_ops_per_thread,
+            double cooldown_sec, double max_execution_sec)
+      : warmup_end(start + std::chrono::duration_cast<Clock::duration>(
+                               std::chrono::duration<double>(warmup_sec))),
+        warmup_ops(warmup_ops_per_thread),
+        measure_begin(std::numeric_limits<int64_t>::max()),
+        measure_end(std::numeric_limits<int64_t>::min()) {
+    if (max_execution_sec > 0) {
+      deadline = start + std::chrono::duration_cast<Clock::duration>(
+                             std::chrono::duration<double>(max_execution_sec));
+      cooldown_start = deadline - std::chrono::duration_cast<Clock::duration>(
+                                      std::chrono::duration<double>(cooldown_sec));
+    } else {
+      deadline = Clock::time_point::max();
+      cooldown_start = Clock::time_point::max();
+    }
+  }
+
+  void RecordMeasured(Clock::time_point begin, Clock::time_point end) {
+    int64_t b = begin.time_since_epoch().count();
+    int64_t e = end.time_since_epoch().count();
+    int64_t cur = measure_begin.load();
+    while (b < cur && !measure_begin.compare_exchange_weak(cur, b)) {}
+    cur = measure_end.load();
+    while (e > cur && !measure_end.compare_exchange_weak(cur, e)) {}
+  }
+
+  ///
+  /// Returns the span of the measured operations in seconds, 0 if none.
+  ///
+  double MeasuredSeconds() const {
+    int64_t b = measure_begin.load();
+    int64_t e = measure_end.load();
+    if (e < b) {
+      return 0;
+    }
+    return std::chrono::duration<double>(Clock::duration(e - b)).count();
+  }
+
+  Clock::time_point warmup_end;
+  Clock::time_point cooldown_start;
+  Clock::time_point deadline;
+  const int warmup_ops;
+  std::atomic<int64_t> measure_begin;
+  std::atomic<int64_t> measure_end;
+};
+
+///
+/// Runs num_ops operations against db and returns the number of measured ones.
+/// Without limits all operations are measured. With a queue_depth above 1 the
+/// operations are issued asynchronously, keeping up to queue_depth in flight.
+///
+inline int ClientThread(ycsbc::DBWrapper *db, ycsbc::Workload *wl, const int num_ops, bool is_loading,
+                        bool init_db, bool cleanup_db, utils::CountDownLatch *latch, utils::RateLimiter *rlim,
+                        int queue_depth, RunLimits *limits, uint64_t rng_stream) {
 
   try {
+    utils::SetThreadRandomStream(rng_stream);
     if (init_db) {
       db->Init();
     }
 
     int ops = 0;
+    int outstanding = 0;
+    auto on_done = [&outstanding](bool) { outstanding--; };
+    bool last_measuring = false;
+    RunLimits::Clock::time_point measure_begin, measure_end;
     for (int i = 0; i < num_ops; ++i) {
+      while (outstanding >= queue_depth) {
+        db->Poll(true);
+      }
+
+      // the rate limiter sleeps no further than the deadline, which is checked once it returns
+      std::chrono::steady_clock::time_point scheduled;
       if (rlim) {
-        rlim->Consume(1);
+        scheduled = rlim->Consume(1, limits ? limits->deadline : RunLimits::Clock::time_point::max());
       }
 
-      if (is_loading) {
+      bool measuring = true;
+      RunLimits::Clock::time_point now = RunLimits::Clock::now();
+      if (limits) {
+        if (now >= limits->deadline) {
+          break;
+        }
+        measuring = i >= limits->warmup_ops && now >= limits->warmup_end && now < limits->cooldown_start;
+        db->SetMeasuring(measuring);
+      }
+
+      // an operation delayed by a stalled predecessor still counts from its scheduled start,
+      // the clock is read once Consume() has slept so the wait itself does not count
+      db->SetIntendedStart(rlim ? std::min(scheduled, now) : now);
+
+      if (queue_depth > 1) {
+        outstanding++;
+        if (is_loading) {
+          wl->DoInsertAsync(*db, on_done);
+        } else {
+          wl->DoTransactionAsync(*db, on_done);
+        }
+      } else if (is_loading) {
         wl->DoInsert(*db);
       } else {
         wl->DoTransaction(*db);
       }
-      ops++;
+      last_measuring = measuring;
+      if (measuring) {
+        if (limits) {
+          if (ops == 0) {
+            measure_begin = now;
+          }
+          measure_end = RunLimits::Clock::now();
+        }
+        ops++;
+      }
+    }
+
+    while (outstanding > 0) {
+      db->Poll(true);
+    }
+
+    if (limits) {
+      if (last_measuring) {
+        measure_end = RunLimits::Clock::now();
+      }
+      if (ops > 0) {
+        limits->RecordMeasured(measure_begin, measure_end);
+      }
+      db->SetMeasuring(true);
+    }
+
+    if (cleanup_db) {
+      db->Cleanup();
+    }
+
+    latch->CountDown();
+    return ops;
+  } catch (const utils::Exception &e) {
+    std::cerr << "Caught exception: " << e.what() << std::endl;
+    exit(1);
+  }
+}
+
+///
+/// Loads the records first to first + num_ops - 1 through Workload::DoBulkLoad.
+///
+inline int BulkLoadThread(ycsbc::DBWrapper *db, ycsbc::Workload *wl, uint64_t first, const int num_ops,
+                          bool init_db, bool cleanup_db, utils::CountDownLatch *latch, uint64_t rng_stream) {
+  try {
+    utils::SetThreadRandomStream(rng_stream);
+    if (init_db) {
+      db->Init();
     }
 
+    int ops = static_cast<int>(wl->DoBulkLoad(*db, first, num_ops));
+
     if (cleanup_db) {
       db->Cleanup();
     }
@@ -12,9 +12,13 @@
 #include "zipfian_generator.h"
 #include "scrambled_zipfian_generator.h"
 #include "skewed_latest_generator.h"
+#include "hotspot_generator.h"
+#include "sequential_generator.h"
+#include "exponential_generator.h"
+#include "shifting_generator.h"
 #include "const_generator.h"
 #include "core_workload.h"
-#include "random_byte_generator.h"
+#include "random_byte_pool.h"
 #include "utils/utils.h"
 #include "workload_factory.h"
 
@@ -32,12 +36,16 @@ const char *ycsbc::kOperationString[ycsbc::MAXOPTYPE] = {
   "SCAN",
   "READMODIFYWRITE",
   "DELETE",
+  "MULTIREAD",
+  "BATCHWRITE",
   "INSERT-FAILED",
   "READ-FAILED",
   "UPDATE-FAILED",
   "SCAN-FAILED",
   "READMODIFYWRITE-FAILED",
-  "DELETE-FAILED"
+  "DELETE-FAILED",
+  "MULTIREAD-FAILED",
+  "BATCHWRITE-FAILED"
 };
 
 const string CoreWorkload::TABLENAME_PROPERTY = "table";
@@ -52,6 +60,9 @@ const string CoreWorkload::FIELD_LENGTH_DISTRIBUTION_DEFAULT = "constant";
 const string CoreWorkload::FIELD_LENGTH_PROPERTY = "fieldlength";
 const string CoreWorkload::FIELD_LENGTH_DEFAULT = "100";
 
+const string CoreWorkload::VALUE_COMPRESSIBILITY_PROPERTY = "value.compressibility";
+const string CoreWorkload::VALUE_COMPRESSIBILITY_DEFAULT = "1.0";
+
 const string CoreWorkload::READ_ALL_FIELDS_PROPERTY = "readallfields";
 const string CoreWorkload::READ_ALL_FIELDS_DEFAULT = "true";
 
@@ -73,9 +84,42 @@ const string CoreWorkload::SCAN_PROPORTION_DEFAULT = "0.0";
 const string CoreWorkload::READMODIFYWRITE_PROPORTION_PROPERTY = "readmodifywriteproportion";
 const string CoreWorkload::READMODIFYWRITE_PROPORTION_DEFAULT = "0.0";
 
+const string CoreWorkload::BATCH_READ_PROPORTION_PROPERTY = "batchreadproportion";
+const string CoreWorkload::BATCH_READ_PROPORTION_DEFAULT = "0.0";
+
+const string CoreWorkload::BATCH_WRITE_PROPORTION_PROPERTY = "batchwriteproportion";
+const string CoreWorkload::BATCH_WRITE_PROPORTION_DEFAULT = "0.0";
+
+const string CoreWorkload::BATCH_SIZE_PROPERTY = "batchsize";
+const string CoreWorkload::BATCH_SIZE_DEFAULT = "10";
+
 const string CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY = "requestdistribution";
 const string CoreWorkload::REQUEST_DISTRIBUTION_DEFAULT = "uniform";
 
+const string CoreWorkload::HOTSPOT_DATA_FRACTION_PROPERTY = "hotspotdatafraction";
+const string CoreWorkload::HOTSPOT_DATA_FRACTION_DEFAULT = "0.2";
+
+const string CoreWorkload::HOTSPOT_OPN_FRACTION_PROPERTY = "hotspotopnfraction";
+const string CoreWorkload::HOTSPOT_OPN_FRACTION_DEFAULT = "0.8";
+
+const string CoreWorkload::EXPONENTIAL_PERCENTILE_PROPERTY = "exponential.percentile";
+const string CoreWorkload::EXPONENTIAL_PERCENTILE_DEFAULT = "95";
+
+const string CoreWorkload::EXPONENTIAL_FRAC_PROPERTY = "exponential.frac";
+const string CoreWorkload::EXPONENTIAL_FRAC_DEFAULT = "0.8571428571";
+
+const string CoreWorkload::SHIFTING_SCHEDULE_PROPERTY = "shifting.schedule";
+const string CoreWorkload::SHIFTING_SCHEDULE_DEFAULT = "ops";
+
+const string CoreWorkload::SHIFTING_PERIOD_PROPERTY = "shifting.period";
+const string CoreWorkload::SHIFTING_PERIOD_DEFAULT = "1000000";
+
+const string CoreWorkload::SHIFTING_FRACTION_PROPERTY = "shifting.fraction";
+const string CoreWorkload::SHIFTING_FRACTION_DEFAULT = "0.1";
+
+const string CoreWorkload::SHIFTING_MODE_PROPERTY = "shifting.mode";
+const string CoreWorkload::SHIFTING_MODE_DEFAULT = "jump";
+
 const string CoreWorkload::ZERO_PADDING_PROPERTY = "zeropadding";
 const string CoreWorkload::ZERO_PADDING_DEFAULT = "1";
 
@@ -106,7 +150,13 @@ void CoreWorkload::Init(const utils::Properties &p) {
 
   field_count_ = std::stoi(p.GetProperty(FIELD_COUNT_PROPERTY, FIELD_COUNT_DEFAULT));
   field_prefix_ = p.GetProperty(FIELD_NAME_PREFIX, FIELD_NAME_PREFIX_DEFAULT);
+  field_names_.clear();
+  for (int i = 0; i < field_count_; i++) {
+    field_names_.push_back(field_prefix_ + std::to_string(i));
+  }
   field_len_generator_ = GetFieldLenGenerator(p);
+  RandomBytePool::SetCompressibility(std::stod(p.GetProperty(VALUE_COMPRESSIBILITY_PROPERTY,
+                                                             VALUE_COMPRESSIBILITY_DEFAULT)));
 
   double read_proportion = std::stod(p.GetProperty(READ_PROPORTION_PROPERTY,
                                                    READ_PROPORTION_DEFAULT));
@@ -118,6 +168,14 @@ void CoreWorkload::Init(const utils::Properties &p) {
                                                    SCAN_PROPORTION_DEFAULT));
   double readmodifywrite_proportion = std::stod(p.GetProperty(
       READMODIFYWRITE_PROPORTION_PROPERTY, READMODIFYWRITE_PROPORTION_DEFAULT));
+  double batch_read_proportion = std::stod(p.GetProperty(BATCH_READ_PROPORTION_PROPERTY,
+                                                         BATCH_READ_PROPORTION_DEFAULT));
+  double batch_write_proportion = std::stod(p.GetProperty(BATCH_WRITE_PROPORTION_PROPERTY,
+                                                          BATCH_WRITE_PROPORTION_DEFAULT));
+  batch_size_ = std::stoi(p.GetProperty(BATCH_SIZE_PROPERTY, BATCH_SIZE_DEFAULT));
+  if (batch_size_ < 1) {
+    throw utils::Exception("batchsize must be at least 1");
+  }
 
   record_count_ = std::stoi(p.GetProperty(RECORD_COUNT_PROPERTY));
   std::string request_dist = p.GetProperty(REQUEST_DISTRIBUTION_PROPERTY,
@@ -126,9 +184,10 @@ void CoreWorkload::Init(const utils::Properties &p) {
   int max_scan_len = std::stoi(p.GetProperty(MAX_SCAN_LENGTH_PROPERTY, MAX_SCAN_LENGTH_DEFAULT));
   std::string scan_len_dist = p.GetProperty(SCAN_LENGTH_DISTRIBUTION_PROPERTY,
                                             SCAN_LENGTH_DISTRIBUTION_DEFAULT);
-  int insert_start = std::stoi(p.GetProperty(INSERT_START_PROPERTY, INSERT_START_DEFAULT));
+  insert_start_ = std::stoi(p.GetProperty(INSERT_START_PROPERTY, INSERT_START_DEFAULT));
 
   zero_padding_ = std::stoi(p.GetProperty(ZERO_PADDING_PROPERTY, ZERO_PADDING_DEFAULT));
+  key_format_ = KeyFormat(p, zero_padding_);
 
   read_all_fields_ = utils::StrToBool(p.GetProperty(READ_ALL_FIELDS_PROPERTY,
                                                     READ_ALL_FIELDS_DEFAULT));
@@ -157,14 +216,20 @@ void CoreWorkload::Init(const utils::Properties &p) {
   if (readmodifywrite_proportion > 0) {
     op_chooser_.AddValue(READMODIFYWRITE, readmodifywrite_proportion);
   }
+  if (batch_read_proportion > 0) {
+    op_chooser_.AddValue(MULTIREAD, batch_read_proportion);
+  }
+  if (batch_write_proportion > 0) {
+    op_chooser_.AddValue(BATCHWRITE, batch_write_proportion);
+  }
 
-  insert_key_sequence_ = new CounterGenerator(insert_start);
+  insert_key_sequence_ = new CounterGenerator(insert_start_);
   transaction_insert_key_sequence_ = new AcknowledgedCounterGenerator(record_count_);
 
   if (request_dist == "uniform") {
     key_chooser_ = new UniformGenerator(0, record_count_ - 1);
 
-  } else if (request_dist == "zipfian") {
+  } else if (request_dist == "zipfian" || request_dist == "shifting") {
     // If the number of keys changes, we don't want to change popular keys.
     // So we construct the scrambled zipfian generator with a keyspace
     // that is larger than what exists at the beginning of the test.
@@ -178,8 +243,38 @@ void CoreWorkload::Init(const utils::Properties &p) {
     } else {
       key_chooser_ = new ScrambledZipfianGenerator(record_count_ + new_keys);
     }
+    if (request_dist == "shifting") {
+      std::string schedule = p.GetProperty(SHIFTING_SCHEDULE_PROPERTY, SHIFTING_SCHEDULE_DEFAULT);
+      std::string mode = p.GetProperty(SHIFTING_MODE_PROPERTY, SHIFTING_MODE_DEFAULT);
+      if (schedule != "ops" && schedule != "time") {
+        throw utils::Exception("Unknown shifting schedule: " + schedule);
+      }
+      if (mode != "jump" && mode != "drift") {
+        throw utils::Exception("Unknown shifting mode: " + mode);
+      }
+      key_chooser_ = new ShiftingGenerator(
+          key_chooser_, *transaction_insert_key_sequence_,
+          schedule == "ops" ? ShiftingGenerator::Schedule::kOps : ShiftingGenerator::Schedule::kTime,
+          std::stoull(p.GetProperty(SHIFTING_PERIOD_PROPERTY, SHIFTING_PERIOD_DEFAULT)),
+          std::stod(p.GetProperty(SHIFTING_FRACTION_PROPERTY, SHIFTING_FRACTION_DEFAULT)),
+          mode == "drift");
+    }
   } else if (request_dist == "latest") {
     key_chooser_ = new SkewedLatestGenerator(*transaction_insert_key_sequence_);
+  } else if (request_dist == "hotspot") {
+    double hot_set_fraction = std::stod(p.GetProperty(HOTSPOT_DATA_FRACTION_PROPERTY,
+                                                      HOTSPOT_DATA_FRACTION_DEFAULT));
+    double hot_op_fraction = std::stod(p.GetProperty(HOTSPOT_OPN_FRACTION_PROPERTY,
+                                                     HOTSPOT_OPN_FRACTION_DEFAULT));
+    key_chooser_ = new HotspotGenerator(0, record_count_ - 1, hot_set_fraction, hot_op_fraction);
+  } else if (request_dist == "sequential") {
+    key_chooser_ = new SequentialGenerator(0, record_count_ - 1);
+  } else if (request_dist == "exponential") {
+    double percentile = std::stod(p.GetProperty(EXPONENTIAL_PERCENTILE_PROPERTY,
+                                                EXPONENTIAL_PERCENTILE_DEFAULT));
+    double frac = std::stod(p.GetProperty(EXPONENTIAL_FRAC_PROPERTY, EXPONENTIAL_FRAC_DEFAULT));
+    key_chooser_ = new ExponentialGenerator(*transaction_insert_key_sequence_, percentile,
+                                            record_count_ * frac);
   } else {
     throw utils::Exception("Unknown request distribution: " + request_dist);
   }
@@ -211,36 +306,32 @@ ycsbc::Generator<uint64_t> *CoreWorkload::GetFieldLenGenerator(
   }
 }
 
-std::string CoreWorkload::BuildKeyName(uint64_t key_num) {
+void CoreWorkload::BuildKeyName(uint64_t key_num, std::string &key) {
   if (!ordered_inserts_) {
     key_num = utils::Hash(key_num);
   }
-  std::string prekey = "user";
-  std::string value = std::to_string(key_num);
-  int fill = std::max(0, zero_padding_ - static_cast<int>(value.size()));
-  return prekey.append(fill, '0').append(value);
+  key_format_.Encode(key_num, key);
 }
 
 void CoreWorkload::BuildValues(std::vector<ycsbc::DB::Field> &values) {
+  values.resize(field_count_);
   for (int i = 0; i < field_count_; ++i) {
-    values.push_back(DB::Field());
-    ycsbc::DB::Field &field = values.back();
-    field.name.append(field_prefix_).append(std::to_string(i));
-    uint64_t len = field_len_generator_->Next();
-    field.value.reserve(len);
-    RandomByteGenerator byte_generator;
-    std::generate_n(std::back_inserter(field.value), len, [&]() { return byte_generator.Next(); } );
+    ycsbc::DB::Field &field = values[i];
+    field.name.assign(field_names_[i]);
+    RandomBytePool::Fill(field.value, field_len_generator_->Next());
   }
 }
 
 void CoreWorkload::BuildSingleValue(std::vector<ycsbc::DB::Field> &values) {
-  values.push_back(DB::Field());
-  ycsbc::DB::Field &field = values.back();
-  field.name.append(NextFieldName());
-  uint64_t len = field_len_generator_->Next();
-  field.value.reserve(len);
-  RandomByteGenerator byte_generator;
-  std::generate_n(std::back_inserter(field.value), len, [&]() { return byte_generator.Next(); } );
+  values.resize(1);
+  ycsbc::DB::Field &field = values[0];
+  field.name.assign(NextFieldName());
+  RandomBytePool::Fill(field.value, field_len_generator_->Next());
+}
+
+CoreWorkload::LocalBuffers &CoreWorkload::Local() {
+  static thread_local LocalBuffers buffers;
+  return buffers;
 }
 
 uint64_t CoreWorkload::NextTransactionKeyNum() {
@@ -251,17 +342,32 @@ uint64_t CoreWorkload::NextTransactionKeyNum() {
   return key_num;
 }
 
-std::string CoreWorkload::NextFieldName() {
-  return std::string(field_prefix_).append(std::to_string(field_chooser_->Next()));
+const std::string &CoreWorkload::NextFieldName() {
+  return field_names_[field_chooser_->Next()];
 }
 
 bool CoreWorkload::DoInsert(DB &db) {
-  const std::string key = BuildKeyName(insert_key_sequence_->Next());
-  std::vector<DB::Field> fields;
+  std::string &key = Local().key;
+  BuildKeyName(insert_key_sequence_->Next(), key);
+  std::vector<DB::Field> &fields = Local().values;
   BuildValues(fields);
   return db.Insert(table_name_, key, fields) == DB::kOK;
 }
 
+uint64_t CoreWorkload::DoBulkLoad(DB &db, uint64_t first, uint64_t count) {
+  // the same records DoInsert would produce for this part of the insert sequence
+  std::vector<std::string> keys(count);
+  for (uint64_t i = 0; i < count; i++) {
+    BuildKeyName(insert_start_ + first + i, keys[i]);
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  DB::Status s = db.BulkLoad(table_name_, keys, [this](std::vector<DB::Field> &values) {
+    BuildValues(values);
+  });
+  return s == DB::kOK ? keys.size() : 0;
+}
+
 bool CoreWorkload::DoTransaction(DB &db) {
   DB::Status status;
   switch (op_chooser_.Next()) {
@@ -280,39 +386,47 @@ bool CoreWorkload::DoTransaction(DB &db) {
     case READMODIFYWRITE:
       status = TransactionReadModifyWrite(db);
       break;
+    case MULTIREAD:
+      status = TransactionMultiRead(db);
+      break;
+    case BATCHWRITE:
+      status = TransactionBatchWrite(db);
+      break;
     default:
       throw utils::Exception("Operation request is not recognized!");
   }
   return (status == DB::kOK);
 }
 
+const std::vector<std::string> *CoreWorkload::NextReadFields() {
+  if (read_all_fields()) {
+    return NULL;
+  }
+  std::vector<std::string> &fields = Local().fields;
+  fields.resize(1);
+  fields[0] = NextFieldName();
+  return &fields;
+}
+
 DB::Status CoreWorkload::TransactionRead(DB &db) {
   uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> result;
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    return db.Read(table_name_, key, &fields, result);
-  } else {
-    return db.Read(table_name_, key, NULL, result);
-  }
+  std::string &key = Local().key;
+  BuildKeyName(key_num, key);
+  // the bindings append to the result
+  std::vector<DB::Field> &result = Local().result;
+  result.clear();
+  return db.Read(table_name_, key, NextReadFields(), result);
 }
 
 DB::Status CoreWorkload::TransactionReadModifyWrite(DB &db) {
   uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> result;
-
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    db.Read(table_name_, key, &fields, result);
-  } else {
-    db.Read(table_name_, key, NULL, result);
-  }
+  std::string &key = Local().key;
+  BuildKeyName(key_num, key);
+  std::vector<DB::Field> &result = Local().result;
+  result.clear();
+  db.Read(table_name_, key, NextReadFields(), result);
 
-  std::vector<DB::Field> values;
+  std::vector<DB::Field> &values = Local().values;
   if (write_all_fields()) {
     BuildValues(values);
   } else {
@@ -323,22 +437,19 @@ DB::Status CoreWorkload::TransactionReadModifyWrite(DB &db) {
 
 DB::Status CoreWorkload::TransactionScan(DB &db) {
   uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
+  std::string &key = Local().key;
+  BuildKeyName(key_num, key);
   int len = scan_len_chooser_->Next();
-  std::vector<std::vector<DB::Field>> result;
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    return db.Scan(table_name_, key, len, &fields, result);
-  } else {
-    return db.Scan(table_name_, key, len, NULL, result);
-  }
+  std::vector<std::vector<DB::Field>> &result = Local().records;
+  result.clear();
+  return db.Scan(table_name_, key, len, NextReadFields(), result);
 }
 
 DB::Status CoreWorkload::TransactionUpdate(DB &db) {
   uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> values;
+  std::string &key = Local().key;
+  BuildKeyName(key_num, key);
+  std::vector<DB::Field> &values = Local().values;
   if (write_all_fields()) {
     BuildValues(values);
   } else {
@@ -349,14 +460,173 @@ DB::Status CoreWorkload::TransactionUpdate(DB &db) {
 
 DB::Status CoreWorkload::TransactionInsert(DB &db) {
   uint64_t key_num = transaction_insert_key_sequence_->Next();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> values;
+  std::string &key = Local().key;
+  BuildKeyName(key_num, key);
+  std::vector<DB::Field> &values = Local().values;
   BuildValues(values);
   DB::Status s = db.Insert(table_name_, key, values);
   transaction_insert_key_sequence_->Acknowledge(key_num);
   return s;
 }
 
+DB::Status CoreWorkload::TransactionMultiRead(DB &db) {
+  std::vector<std::string> &keys = Local().keys;
+  keys.resize(batch_size_);
+  for (int i = 0; i < batch_size_; i++) {
+    BuildKeyName(NextTransactionKeyNum(), keys[i]);
+  }
+  std::vector<std::vector<DB::Field>> &result = Local().records;
+  result.clear();
+  return db.MultiRead(table_name_, keys, NextReadFields(), result);
+}
+
+DB::Status CoreWorkload::TransactionBatchWrite(DB &db) {
+  // new records, like inserts, so the batch grows the key space the readers see
+  std::vector<uint64_t> key_nums;
+  std::vector<std::string> &keys = Local().keys;
+  std::vector<std::vector<DB::Field>> &values = Local().batch;
+  keys.resize(batch_size_);
+  values.resize(batch_size_);
+  key_nums.reserve(batch_size_);
+  for (int i = 0; i < batch_size_; i++) {
+    key_nums.push_back(transaction_insert_key_sequence_->Next());
+    BuildKeyName(key_nums.back(), keys[i]);
+    BuildValues(values[i]);
+  }
+  DB::Status s = db.BatchWrite(table_name_, keys, values);
+  for (uint64_t key_num : key_nums) {
+    transaction_insert_key_sequence_->Acknowledge(key_num);
+  }
+  return s;
+}
+
+void CoreWorkload::DoInsertAsync(DB &db, std::function<void(bool)> done) {
+  AsyncOp *op = new AsyncOp;
+  op->done = std::move(done);
+  BuildKeyName(insert_key_sequence_->Next(), op->key);
+  BuildValues(op->values);
+  db.InsertAsync(table_name_, op->key, op->values, [op](DB::Status s) { FinishAsync(op, s); });
+}
+
+void CoreWorkload::DoTransactionAsync(DB &db, std::function<void(bool)> done) {
+  AsyncOp *op = new AsyncOp;
+  op->done = std::move(done);
+  switch (op_chooser_.Next()) {
+    case READ:
+      TransactionReadAsync(db, op);
+      break;
+    case UPDATE:
+      TransactionUpdateAsync(db, op);
+      break;
+    case INSERT:
+      TransactionInsertAsync(db, op);
+      break;
+    case SCAN:
+      TransactionScanAsync(db, op);
+      break;
+    case READMODIFYWRITE:
+      TransactionReadModifyWriteAsync(db, op);
+      break;
+    case MULTIREAD:
+      TransactionMultiReadAsync(db, op);
+      break;
+    case BATCHWRITE:
+      TransactionBatchWriteAsync(db, op);
+      break;
+    default:
+      delete op;
+      throw utils::Exception("Operation request is not recognized!");
+  }
+}
+
+void CoreWorkload::FinishAsync(AsyncOp *op, DB::Status status) {
+  op->done(status == DB::kOK);
+  delete op;
+}
+
+const std::vector<std::string> *CoreWorkload::NextReadFields(AsyncOp *op) {
+  if (read_all_fields()) {
+    return NULL;
+  }
+  op->fields.push_back(NextFieldName());
+  return &op->fields;
+}
+
+void CoreWorkload::TransactionReadAsync(DB &db, AsyncOp *op) {
+  BuildKeyName(NextTransactionKeyNum(), op->key);
+  db.ReadAsync(table_name_, op->key, NextReadFields(op), op->values,
+               [op](DB::Status s) { FinishAsync(op, s); });
+}
+
+void CoreWorkload::TransactionReadModifyWriteAsync(DB &db, AsyncOp *op) {
+  BuildKeyName(NextTransactionKeyNum(), op->key);
+  // the write is issued once the read completes, like in the synchronous version
+  db.ReadAsync(table_name_, op->key, NextReadFields(op), op->values,
+               [this, &db, op](DB::Status) {
+    if (write_all_fields()) {
+      BuildValues(op->values);
+    } else {
+      BuildSingleValue(op->values);
+    }
+    db.UpdateAsync(table_name_, op->key, op->values, [op](DB::Status s) { FinishAsync(op, s); });
+  });
+}
+
+void CoreWorkload::TransactionScanAsync(DB &db, AsyncOp *op) {
+  BuildKeyName(NextTransactionKeyNum(), op->key);
+  int len = scan_len_chooser_->Next();
+  db.ScanAsync(table_name_, op->key, len, NextReadFields(op), op->records,
+               [op](DB::Status s) { FinishAsync(op, s); });
+}
+
+void CoreWorkload::TransactionUpdateAsync(DB &db, AsyncOp *op) {
+  BuildKeyName(NextTransactionKeyNum(), op->key);
+  if (write_all_fields()) {
+    BuildValues(op->values);
+  } else {
+    BuildSingleValue(op->values);
+  }
+  db.UpdateAsync(table_name_, op->key, op->values, [op](DB::Status s) { FinishAsync(op, s); });
+}
+
+void CoreWorkload::TransactionInsertAsync(DB &db, AsyncOp *op) {
+  uint64_t key_num = transaction_insert_key_sequence_->Next();
+  BuildKeyName(key_num, op->key);
+  BuildValues(op->values);
+  db.InsertAsync(table_name_, op->key, op->values, [this, op, key_num](DB::Status s) {
+    transaction_insert_key_sequence_->Acknowledge(key_num);
+    FinishAsync(op, s);
+  });
+}
+
+void CoreWorkload::TransactionMultiReadAsync(DB &db, AsyncOp *op) {
+  op->keys.resize(batch_size_);
+  for (int i = 0; i < batch_size_; i++) {
+    BuildKeyName(NextTransactionKeyNum(), op->keys[i]);
+  }
+  db.MultiReadAsync(table_name_, op->keys, NextReadFields(op), op->records,
+                    [op](DB::Status s) { FinishAsync(op, s); });
+}
+
+void CoreWorkload::TransactionBatchWriteAsync(DB &db, AsyncOp *op) {
+  std::vector<uint64_t> key_nums;
+  key_nums.reserve(batch_size_);
+  op->keys.resize(batch_size_);
+  op->records.resize(batch_size_);
+  for (int i = 0; i < batch_size_; i++) {
+    key_nums.push_back(transaction_insert_key_sequence_->Next());
+    BuildKeyName(key_nums.back(), op->keys[i]);
+    BuildValues(op->records[i]);
+  }
+  db.BatchWriteAsync(table_name_, op->keys, op->records,
+                     [this, op, key_nums](DB::Status s) {
+    for (uint64_t key_num : key_nums) {
+      transaction_insert_key_sequence_->Acknowledge(key_num);
+    }
+    FinishAsync(op, s);
+  });
+}
+
 Workload* NewCoreWorkload() {
   return new CoreWorkload();
 }
@@ -11,6 +11,7 @@
 #ifndef YCSB_C_CORE_WORKLOAD_H_
 #define YCSB_C_CORE_WORKLOAD_H_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include "db.h"
@@ -18,6 +19,7 @@
 #include "discrete_generator.h"
 #include "counter_generator.h"
 #include "acknowledged_counter_generator.h"
+#include "key_format.h"
 #include "utils/properties.h"
 #include "utils/utils.h"
 #include "workload.h"
@@ -51,6 +53,13 @@ class CoreWorkload: public Workload {
   static const std::string FIELD_LENGTH_PROPERTY;
   static const std::string FIELD_LENGTH_DEFAULT;
 
+  ///
+  /// The name of the property for the compressibility of field values,
+  /// as the target ratio of compressed to raw size in (0, 1].
+  ///
+  static const std::string VALUE_COMPRESSIBILITY_PROPERTY;
+  static const std::string VALUE_COMPRESSIBILITY_DEFAULT;
+
   ///
   /// The name of the property for deciding whether to read one field (false)
   /// or all fields (true) of a record.
@@ -96,13 +105,74 @@ class CoreWorkload: public Workload {
   static const std::string READMODIFYWRITE_PROPORTION_PROPERTY;
   static const std::string READMODIFYWRITE_PROPORTION_DEFAULT;
 
+  ///
+  /// The name of the property for the proportion of transactions
+  /// that read a batch of records at once.
+  ///
+  static const std::string BATCH_READ_PROPORTION_PROPERTY;
+  static const std::string BATCH_READ_PROPORTION_DEFAULT;
+
+  ///
+  /// The name of the property for the proportion of transactions
+  /// that insert a batch of records at once.
+  ///
+  static const std::string BATCH_WRITE_PROPORTION_PROPERTY;
+  static const std::string BATCH_WRITE_PROPORTION_DEFAULT;
+
+  ///
+  /// The name of the property for the number of records in a batch.
+  ///
+  static const std::string BATCH_SIZE_PROPERTY;
+  static const std::string BATCH_SIZE_DEFAULT;
+
   ///
   /// The name of the property for the the distribution of request keys.
-  /// Options are "uniform", "zipfian" and "latest".
+  /// Options are "uniform", "zipfian", "latest", "hotspot", "sequential",
+  /// "exponential" and "shifting".
   ///
   static const std::string REQUEST_DISTRIBUTION_PROPERTY;
   static const std::string REQUEST_DISTRIBUTION_DEFAULT;
 
+  ///
+  /// The name of the property for the fraction of the records in the hot set
+  /// of the hotspot distribution, the first ones in key number order.
+  ///
+  static const std::string HOTSPOT_DATA_FRACTION_PROPERTY;
+  static const std::string HOTSPOT_DATA_FRACTION_DEFAULT;
+
+  ///
+  /// The name of the property for the fraction of the requests to the hot set
+  /// of the hotspot distribution.
+  ///
+  static const std::string HOTSPOT_OPN_FRACTION_PROPERTY;
+  static const std::string HOTSPOT_OPN_FRACTION_DEFAULT;
+
+  ///
+  /// The names of the properties for the exponential distribution: the
+  /// percentage of the requests to the most recent exponential.frac of the
+  /// records.
+  ///
+  static const std::string EXPONENTIAL_PERCENTILE_PROPERTY;
+  static const std::string EXPONENTIAL_PERCENTILE_DEFAULT;
+  static const std::string EXPONENTIAL_FRAC_PROPERTY;
+  static const std::string EXPONENTIAL_FRAC_DEFAULT;
+
+  ///
+  /// The names of the properties for the shifting distribution, a scrambled
+  /// zipfian whose popular keys move by shifting.fraction of the key space
+  /// every shifting.period, at once ("jump") or gradually ("drift") as set
+  /// by shifting.mode. The period is in operations or in milliseconds, as
+  /// set by shifting.schedule ("ops" or "time").
+  ///
+  static const std::string SHIFTING_SCHEDULE_PROPERTY;
+  static const std::string SHIFTING_SCHEDULE_DEFAULT;
+  static const std::string SHIFTING_PERIOD_PROPERTY;
+  static const std::string SHIFTING_PERIOD_DEFAULT;
+  static const std::string SHIFTING_FRACTION_PROPERTY;
+  static const std::string SHIFTING_FRACTION_DEFAULT;
+  static const std::string SHIFTING_MODE_PROPERTY;
+  static const std::string SHIFTING_MODE_DEFAULT;
+
   ///
   /// The default zero padding value. Matches integer sort order
   ///
@@ -157,6 +227,9 @@ class CoreWorkload: public Workload {
 
   virtual bool DoInsert(DB &db);
   virtual bool DoTransaction(DB &db);
+  virtual void DoInsertAsync(DB &db, std::function<void(bool)> done);
+  virtual void DoTransactionAsync(DB &db, std::function<void(bool)> done);
+  virtual uint64_t DoBulkLoad(DB &db, uint64_t first, uint64_t count);
 
   bool read_all_fields() const { return read_all_fields_; }
   bool write_all_fields() const { return write_all_fields_; }
@@ -165,7 +238,8 @@ class CoreWorkload: public Workload {
       field_count_(0), read_all_fields_(false), write_all_fields_(false),
       field_len_generator_(nullptr), key_chooser_(nullptr), field_chooser_(nullptr),
       scan_len_chooser_(nullptr), insert_key_sequence_(nullptr),
-      transaction_insert_key_sequence_(nullptr), ordered_inserts_(true), record_count_(0) {
+      transaction_insert_key_sequence_(nullptr), ordered_inserts_(true), record_count_(0),
+      insert_start_(0), batch_size_(1) {
   }
 
   virtual ~CoreWorkload() {
@@ -179,22 +253,58 @@ class CoreWorkload: public Workload {
 
  protected:
   static Generator<uint64_t> *GetFieldLenGenerator(const utils::Properties &p);
-  std::string BuildKeyName(uint64_t key_num);
+  void BuildKeyName(uint64_t key_num, std::string &key);
   void BuildValues(std::vector<DB::Field> &values);
   void BuildSingleValue(std::vector<DB::Field> &update);
 
   uint64_t NextTransactionKeyNum();
-  std::string NextFieldName();
+  const std::string &NextFieldName();
 
   DB::Status TransactionRead(DB &db);
   DB::Status TransactionReadModifyWrite(DB &db);
   DB::Status TransactionScan(DB &db);
   DB::Status TransactionUpdate(DB &db);
   DB::Status TransactionInsert(DB &db);
+  DB::Status TransactionMultiRead(DB &db);
+  DB::Status TransactionBatchWrite(DB &db);
+
+  // value buffers of the calling thread, reused by the synchronous operations
+  struct LocalBuffers {
+    std::string key;
+    std::vector<std::string> keys;
+    std::vector<std::string> fields;
+    std::vector<DB::Field> values;
+    std::vector<DB::Field> result;
+    std::vector<std::vector<DB::Field>> batch;
+    std::vector<std::vector<DB::Field>> records;
+  };
+  static LocalBuffers &Local();
+  const std::vector<std::string> *NextReadFields();
+
+  // buffers of an asynchronous operation, kept until it completes
+  struct AsyncOp {
+    std::string key;
+    std::vector<std::string> keys;
+    std::vector<std::string> fields;
+    std::vector<DB::Field> values;
+    std::vector<std::vector<DB::Field>> records;
+    std::function<void(bool)> done;
+  };
+  static void FinishAsync(AsyncOp *op, DB::Status status);
+  const std::vector<std::string> *NextReadFields(AsyncOp *op);
+
+  void TransactionReadAsync(DB &db, AsyncOp *op);
+  void TransactionReadModifyWriteAsync(DB &db, AsyncOp *op);
+  void TransactionScanAsync(DB &db, AsyncOp *op);
+  void TransactionUpdateAsync(DB &db, AsyncOp *op);
+  void TransactionInsertAsync(DB &db, AsyncOp *op);
+  void TransactionMultiReadAsync(DB &db, AsyncOp *op);
+  void TransactionBatchWriteAsync(DB &db, AsyncOp *op);
 
   std::string table_name_;
   int field_count_;
   std::string field_prefix_;
+  std::vector<std::string> field_names_;
   bool read_all_fields_;
   bool write_all_fields_;
   Generator<uint64_t> *field_len_generator_;
@@ -206,7 +316,10 @@ class CoreWorkload: public Workload {
   AcknowledgedCounterGenerator *transaction_insert_key_sequence_; // transaction insert key gen
   bool ordered_inserts_;
   size_t record_count_;
+  uint64_t insert_start_;
   int zero_padding_;
+  KeyFormat key_format_;
+  int batch_size_;
 };
 
 } // ycsbc
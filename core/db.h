@@ -11,6 +11,7 @@
 
 #include "utils/properties.h"
 
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -99,6 +100,124 @@ class DB {
   /// @return Zero on success, a non-zero error code on error.
   ///
   virtual Status Delete(const std::string &table, const std::string &key) = 0;
+  ///
+  /// Reads a batch of records from the database.
+  /// The default implementation reads the records one by one.
+  ///
+  /// @param table The name of the table.
+  /// @param keys The keys of the records to read.
+  /// @param fields The list of fields to read, or NULL for all of them.
+  /// @param result One vector of field/value pairs per key, in the order of keys.
+  /// @return Zero if every record was read, or the first non-zero error code.
+  ///
+  virtual Status MultiRead(const std::string &table, const std::vector<std::string> &keys,
+                           const std::vector<std::string> *fields,
+                           std::vector<std::vector<Field>> &result) {
+    Status status = kOK;
+    result.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      result[i].clear();
+      Status s = Read(table, keys[i], fields, result[i]);
+      if (status == kOK) {
+        status = s;
+      }
+    }
+    return status;
+  }
+  ///
+  /// Writes a batch of records to the database in one call.
+  /// Existing records are overwritten, like with Insert. The default
+  /// implementation inserts the records one by one.
+  ///
+  /// @param table The name of the table.
+  /// @param keys The keys of the records to write.
+  /// @param values One vector of field/value pairs per key, in the order of keys.
+  /// @return Zero if every record was written, or the first non-zero error code.
+  ///
+  virtual Status BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                            std::vector<std::vector<Field>> &values) {
+    Status status = kOK;
+    for (size_t i = 0; i < keys.size(); i++) {
+      Status s = Insert(table, keys[i], values[i]);
+      if (status == kOK) {
+        status = s;
+      }
+    }
+    return status;
+  }
+
+  ///
+  /// Loads a range of new records bypassing the regular write path, for DBs
+  /// that can build their files directly. Called concurrently by the loading
+  /// threads. The default implementation inserts the records one by one.
+  ///
+  /// @param table The name of the table.
+  /// @param keys The keys of the records, unique and in ascending byte order.
+  /// @param build_values Replaces the content of the vector with the fields of the next
+  ///                     record, called once per key in order.
+  /// @return Zero if every record was loaded, or a non-zero error code.
+  ///
+  virtual Status BulkLoad(const std::string &table, const std::vector<std::string> &keys,
+                          const std::function<void(std::vector<Field> &)> &build_values) {
+    std::vector<Field> values;
+    for (const std::string &key : keys) {
+      build_values(values);
+      Status s = Insert(table, key, values);
+      if (s != kOK) {
+        return s;
+      }
+    }
+    return kOK;
+  }
+
+  ///
+  /// Completion callback of an asynchronous operation.
+  ///
+  using Callback = std::function<void(Status)>;
+  ///
+  /// Asynchronous versions of the operations above.
+  /// The callback is called with the status once the operation completes, either
+  /// before returning or from a later Poll() of the same thread. All arguments
+  /// must stay valid until then. The default implementations run the
+  /// synchronous operation, so every DB can be driven asynchronously.
+  ///
+  virtual void ReadAsync(const std::string &table, const std::string &key,
+                         const std::vector<std::string> *fields,
+                         std::vector<Field> &result, Callback callback) {
+    callback(Read(table, key, fields, result));
+  }
+  virtual void ScanAsync(const std::string &table, const std::string &key,
+                         int record_count, const std::vector<std::string> *fields,
+                         std::vector<std::vector<Field>> &result, Callback callback) {
+    callback(Scan(table, key, record_count, fields, result));
+  }
+  virtual void UpdateAsync(const std::string &table, const std::string &key,
+                           std::vector<Field> &values, Callback callback) {
+    callback(Update(table, key, values));
+  }
+  virtual void InsertAsync(const std::string &table, const std::string &key,
+                           std::vector<Field> &values, Callback callback) {
+    callback(Insert(table, key, values));
+  }
+  virtual void DeleteAsync(const std::string &table, const std::string &key, Callback callback) {
+    callback(Delete(table, key));
+  }
+  virtual void MultiReadAsync(const std::string &table, const std::vector<std::string> &keys,
+                              const std::vector<std::string> *fields,
+                              std::vector<std::vector<Field>> &result, Callback callback) {
+    callback(MultiRead(table, keys, fields, result));
+  }
+  virtual void BatchWriteAsync(const std::string &table, const std::vector<std::string> &keys,
+                               std::vector<std::vector<Field>> &values, Callback callback) {
+    callback(BatchWrite(table, keys, values));
+  }
+  ///
+  /// Runs the callbacks of completed asynchronous operations.
+  ///
+  /// @param wait Block until at least one operation completes, if any is outstanding.
+  /// @return The number of callbacks run.
+  ///
+  virtual int Poll(bool wait) { return 0; }
 
   virtual ~DB() { }
 
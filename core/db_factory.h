@@ -10,6 +10,7 @@
 #define YCSB_C_DB_FACTORY_H_
 
 #include "db.h"
+#include "db_wrapper.h"
 #include "measurements.h"
 #include "utils/properties.h"
 
@@ -22,7 +23,8 @@ class DBFactory {
  public:
   using DBCreator = DB *(*)();
   static bool RegisterDB(std::string db_name, DBCreator db_creator);
-  static DB *CreateDB(utils::Properties *props, Measurements *measurements);
+  static DBWrapper *CreateDB(utils::Properties *props, Measurements *measurements,
+                             Measurements *intended_measurements = nullptr);
  private:
   static std::map<std::string, DBCreator> &Registry();
 };
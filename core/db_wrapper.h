@@ -8,11 +8,14 @@
 #ifndef YCSB_C_DB_WRAPPER_H_
 #define YCSB_C_DB_WRAPPER_H_
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "db.h"
 #include "measurements.h"
+#include "trace.h"
 #include "utils/timer.h"
 #include "utils/utils.h"
 
@@ -20,7 +23,9 @@ namespace ycsbc {
 
 class DBWrapper : public DB {
  public:
-  DBWrapper(DB *db, Measurements *measurements) : db_(db), measurements_(measurements) {}
+  DBWrapper(DB *db, Measurements *measurements, Measurements *intended_measurements = nullptr)
+      : db_(db), measurements_(measurements), intended_measurements_(intended_measurements),
+        measuring_(true) {}
   ~DBWrapper() {
     delete db_;
   }
@@ -29,67 +34,235 @@ class DBWrapper : public DB {
   }
   void Cleanup() {
     db_->Cleanup();
+    if (trace_) {
+      trace_->Flush();
+    }
+  }
+  ///
+  /// Records the following operations to writer, which must outlive this wrapper.
+  /// Multi-key operations are recorded as one operation per key.
+  ///
+  void SetTraceWriter(TraceWriter *writer) {
+    trace_ = std::make_unique<TraceWriter::Buffer>(writer);
+  }
+  ///
+  /// Sets the time the following operations were scheduled to start at.
+  /// With intended measurements, their latency is also reported from this
+  /// point, which includes the time spent queued behind earlier requests.
+  ///
+  void SetIntendedStart(std::chrono::steady_clock::time_point start) {
+    intended_start_ = start;
+  }
+  ///
+  /// Turns reporting of the following operations on or off, e.g. during warmup.
+  ///
+  void SetMeasuring(bool measuring) {
+    measuring_ = measuring;
   }
   Status Read(const std::string &table, const std::string &key,
               const std::vector<std::string> *fields, std::vector<Field> &result) {
+    Trace(READ, key, 0);
     timer_.Start();
     Status s = db_->Read(table, key, fields, result);
     uint64_t elapsed = timer_.End();
     if (s == kOK) {
-      measurements_->Report(READ, elapsed);
+      Report(READ, elapsed);
     } else {
-      measurements_->Report(READ_FAILED, elapsed);
+      Report(READ_FAILED, elapsed);
     }
     return s;
   }
   Status Scan(const std::string &table, const std::string &key, int record_count,
               const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result) {
+    Trace(SCAN, key, record_count);
     timer_.Start();
     Status s = db_->Scan(table, key, record_count, fields, result);
     uint64_t elapsed = timer_.End();
     if (s == kOK) {
-      measurements_->Report(SCAN, elapsed);
+      Report(SCAN, elapsed);
     } else {
-      measurements_->Report(SCAN_FAILED, elapsed);
+      Report(SCAN_FAILED, elapsed);
     }
     return s;
   }
   Status Update(const std::string &table, const std::string &key, std::vector<Field> &values) {
+    Trace(UPDATE, key, values);
     timer_.Start();
     Status s = db_->Update(table, key, values);
     uint64_t elapsed = timer_.End();
     if (s == kOK) {
-      measurements_->Report(UPDATE, elapsed);
+      Report(UPDATE, elapsed);
     } else {
-      measurements_->Report(UPDATE_FAILED, elapsed);
+      Report(UPDATE_FAILED, elapsed);
     }
     return s;
   }
   Status Insert(const std::string &table, const std::string &key, std::vector<Field> &values) {
+    Trace(INSERT, key, values);
     timer_.Start();
     Status s = db_->Insert(table, key, values);
     uint64_t elapsed = timer_.End();
     if (s == kOK) {
-      measurements_->Report(INSERT, elapsed);
+      Report(INSERT, elapsed);
     } else {
-      measurements_->Report(INSERT_FAILED, elapsed);
+      Report(INSERT_FAILED, elapsed);
     }
     return s;
   }
   Status Delete(const std::string &table, const std::string &key) {
+    Trace(DELETE, key, 0);
     timer_.Start();
     Status s = db_->Delete(table, key);
     uint64_t elapsed = timer_.End();
     if (s == kOK) {
-      measurements_->Report(DELETE, elapsed);
+      Report(DELETE, elapsed);
+    } else {
+      Report(DELETE_FAILED, elapsed);
+    }
+    return s;
+  }
+  Status MultiRead(const std::string &table, const std::vector<std::string> &keys,
+                   const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result) {
+    for (const std::string &key : keys) {
+      Trace(READ, key, 0);
+    }
+    timer_.Start();
+    Status s = db_->MultiRead(table, keys, fields, result);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      Report(MULTIREAD, elapsed);
     } else {
-      measurements_->Report(DELETE_FAILED, elapsed);
+      Report(MULTIREAD_FAILED, elapsed);
     }
     return s;
   }
+  Status BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                    std::vector<std::vector<Field>> &values) {
+    for (size_t i = 0; i < keys.size(); i++) {
+      Trace(INSERT, keys[i], values[i]);
+    }
+    timer_.Start();
+    Status s = db_->BatchWrite(table, keys, values);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      Report(BATCHWRITE, elapsed);
+    } else {
+      Report(BATCHWRITE_FAILED, elapsed);
+    }
+    return s;
+  }
+  // neither measured nor traced, only the throughput of a bulk load is meaningful
+  Status BulkLoad(const std::string &table, const std::vector<std::string> &keys,
+                  const std::function<void(std::vector<Field> &)> &build_values) {
+    return db_->BulkLoad(table, keys, build_values);
+  }
+  void ReadAsync(const std::string &table, const std::string &key,
+                 const std::vector<std::string> *fields, std::vector<Field> &result,
+                 Callback callback) {
+    Trace(READ, key, 0);
+    db_->ReadAsync(table, key, fields, result, Measured(READ, READ_FAILED, std::move(callback)));
+  }
+  void ScanAsync(const std::string &table, const std::string &key, int record_count,
+                 const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result,
+                 Callback callback) {
+    Trace(SCAN, key, record_count);
+    db_->ScanAsync(table, key, record_count, fields, result,
+                   Measured(SCAN, SCAN_FAILED, std::move(callback)));
+  }
+  void UpdateAsync(const std::string &table, const std::string &key, std::vector<Field> &values,
+                   Callback callback) {
+    Trace(UPDATE, key, values);
+    db_->UpdateAsync(table, key, values, Measured(UPDATE, UPDATE_FAILED, std::move(callback)));
+  }
+  void InsertAsync(const std::string &table, const std::string &key, std::vector<Field> &values,
+                   Callback callback) {
+    Trace(INSERT, key, values);
+    db_->InsertAsync(table, key, values, Measured(INSERT, INSERT_FAILED, std::move(callback)));
+  }
+  void DeleteAsync(const std::string &table, const std::string &key, Callback callback) {
+    Trace(DELETE, key, 0);
+    db_->DeleteAsync(table, key, Measured(DELETE, DELETE_FAILED, std::move(callback)));
+  }
+  void MultiReadAsync(const std::string &table, const std::vector<std::string> &keys,
+                      const std::vector<std::string> *fields,
+                      std::vector<std::vector<Field>> &result, Callback callback) {
+    for (const std::string &key : keys) {
+      Trace(READ, key, 0);
+    }
+    db_->MultiReadAsync(table, keys, fields, result,
+                        Measured(MULTIREAD, MULTIREAD_FAILED, std::move(callback)));
+  }
+  void BatchWriteAsync(const std::string &table, const std::vector<std::string> &keys,
+                       std::vector<std::vector<Field>> &values, Callback callback) {
+    for (size_t i = 0; i < keys.size(); i++) {
+      Trace(INSERT, keys[i], values[i]);
+    }
+    db_->BatchWriteAsync(table, keys, values,
+                         Measured(BATCHWRITE, BATCHWRITE_FAILED, std::move(callback)));
+  }
+  int Poll(bool wait) {
+    return db_->Poll(wait);
+  }
  private:
+  void Trace(Operation op, const std::string &key, uint32_t size) {
+    if (trace_) {
+      trace_->Append(op, key, size);
+    }
+  }
+
+  void Trace(Operation op, const std::string &key, const std::vector<Field> &values) {
+    if (trace_) {
+      uint32_t size = 0;
+      for (const Field &field : values) {
+        size += field.value.size();
+      }
+      trace_->Append(op, key, size);
+    }
+  }
+
+  void Report(Operation op, uint64_t elapsed) {
+    if (measuring_) {
+      Report(op, elapsed, intended_start_);
+    }
+  }
+
+  void Report(Operation op, uint64_t elapsed, std::chrono::steady_clock::time_point intended_start) {
+    measurements_->Report(op, elapsed);
+    if (intended_measurements_) {
+      auto intended = std::chrono::steady_clock::now() - intended_start;
+      intended_measurements_->Report(op, std::chrono::duration_cast<std::chrono::nanoseconds>(intended).count());
+    }
+  }
+
+  // times an asynchronous operation from submission to completion, several
+  // of which may be outstanding, so the state is kept in the callback
+  Callback Measured(Operation op, Operation failed_op, Callback callback) {
+    return [this, op, failed_op, start = std::chrono::steady_clock::now(),
+            intended_start = intended_start_, measuring = measuring_,
+            callback = std::move(callback)](Status s) {
+      if (measuring) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Report(s == kOK ? op : failed_op,
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), intended_start);
+      }
+      // an operation the callback issues, e.g. the write of a read-modify-write,
+      // belongs to this one rather than to the operation issued last
+      auto last_intended_start = intended_start_;
+      bool last_measuring = measuring_;
+      intended_start_ = intended_start;
+      measuring_ = measuring;
+      callback(s);
+      intended_start_ = last_intended_start;
+      measuring_ = last_measuring;
+    };
+  }
+
   DB *db_;
   Measurements *measurements_;
+  Measurements *intended_measurements_;
+  std::chrono::steady_clock::time_point intended_start_;
+  bool measuring_;
+  std::unique_ptr<TraceWriter::Buffer> trace_;
   utils::Timer<uint64_t, std::nano> timer_;
 };
 
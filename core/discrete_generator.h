@@ -11,50 +11,120 @@
 
 #include "generator.h"
 
-#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include "utils/utils.h"
 
 namespace ycsbc {
 
+///
+/// Draws values with probabilities proportional to their weights in constant
+/// time, through Walker's alias tables (Vose's construction).
+/// The tables are immutable once built, and the random state and last value
+/// are per thread, so Next() writes no memory shared between threads.
+/// Values must be added before the generator is shared.
+///
 template <typename Value>
 class DiscreteGenerator : public Generator<Value> {
  public:
-  DiscreteGenerator() : sum_(0) { }
+  DiscreteGenerator() = default;
+  explicit DiscreteGenerator(const std::vector<std::pair<Value, double>> &values);
+
+  ///
+  /// Adds a value and rebuilds the tables, in time linear in the values added.
+  ///
   void AddValue(Value value, double weight);
 
   Value Next();
-  Value Last() { return last_; }
+
+  ///
+  /// Returns the value last drawn by the calling thread, or the first value
+  /// if it has drawn none.
+  ///
+  Value Last();
 
  private:
+  // column of the alias table, drawn as value with probability threshold / 2^64
+  struct Column {
+    uint64_t threshold;
+    Value value;
+    Value alias;
+  };
+
+  void Build();
+
   std::vector<std::pair<Value, double>> values_;
-  double sum_;
-  std::atomic<Value> last_;
+  std::vector<Column> columns_;
+  ThreadLocalState<Value> last_;
 };
 
+template <typename Value>
+inline DiscreteGenerator<Value>::DiscreteGenerator(const std::vector<std::pair<Value, double>> &values)
+    : values_(values) {
+  Build();
+}
+
 template <typename Value>
 inline void DiscreteGenerator<Value>::AddValue(Value value, double weight) {
-  if (values_.empty()) {
-    last_ = value;
-  }
   values_.push_back(std::make_pair(value, weight));
-  sum_ += weight;
+  Build();
 }
 
 template <typename Value>
-inline Value DiscreteGenerator<Value>::Next() {
-  double chooser = utils::ThreadLocalRandomDouble();
+inline void DiscreteGenerator<Value>::Build() {
+  const size_t n = values_.size();
+  double sum = 0;
+  for (const auto &p : values_) {
+    sum += p.second;
+  }
 
-  for (auto p = values_.cbegin(); p != values_.cend(); ++p) {
-    if (chooser < p->second / sum_) {
-      return last_ = p->first;
+  columns_.resize(n);
+  std::vector<size_t> small, large;
+  std::vector<double> scaled(n);
+  for (size_t i = 0; i < n; i++) {
+    // full until paired below, as are the columns left over by rounding errors
+    columns_[i] = Column{UINT64_MAX, values_[i].first, values_[i].first};
+    scaled[i] = values_[i].second * n / sum;
+    (scaled[i] < 1.0 ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    size_t s = small.back();
+    size_t l = large.back();
+    small.pop_back();
+    columns_[s].threshold = static_cast<uint64_t>(scaled[s] * 0x1.0p64);
+    columns_[s].alias = values_[l].first;
+    scaled[l] -= 1.0 - scaled[s];
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
     }
-    chooser -= p->second / sum_;
   }
+}
+
+template <typename Value>
+inline Value DiscreteGenerator<Value>::Next() {
+  assert(!values_.empty());
+  // one draw r picks column floor(r * n / 2^64), and the low bits of r * n
+  // are uniform over the column; the side is selected without a branch
+  uint64_t r = utils::ThreadLocalRng().Next();
+  uint64_t n = columns_.size();
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(r) * n;
+  const Column &column = columns_[static_cast<uint64_t>(product >> 64)];
+  uint64_t fraction = static_cast<uint64_t>(product);
+#else
+  const Column &column = columns_[r % n];
+  uint64_t fraction = utils::ThreadLocalRng().Next();
+#endif
+  return last_.Get(values_.front().first) = (fraction < column.threshold) ? column.value : column.alias;
+}
 
-  assert(false);
-  return last_;
+template <typename Value>
+inline Value DiscreteGenerator<Value>::Last() {
+  assert(!values_.empty());
+  return last_.Get(values_.front().first);
 }
 
 } // ycsbc
@@ -0,0 +1,57 @@
+//
+//  exponential_generator.h
+//  YCSB-cpp
+//
+//  Keys at exponentially distributed distances from the latest inserted key,
+//  like the exponential request distribution of YCSB.
+//
+
+#ifndef YCSB_C_EXPONENTIAL_GENERATOR_H_
+#define YCSB_C_EXPONENTIAL_GENERATOR_H_
+
+#include "generator.h"
+
+#include <cmath>
+#include <cstdint>
+#include "counter_generator.h"
+#include "utils/utils.h"
+
+namespace ycsbc {
+
+///
+/// Draws max - d, where max is the last value of the counter and d follows
+/// an exponential distribution with percentile percent of its mass below
+/// range. Distances beyond max are drawn again.
+///
+class ExponentialGenerator : public Generator<uint64_t> {
+ public:
+  ExponentialGenerator(CounterGenerator &counter, double percentile, double range) :
+      basis_(counter), gamma_(-std::log(1.0 - percentile / 100.0) / range) {
+    if (!(percentile > 0 && percentile < 100) || !(range > 0)) {
+      throw utils::Exception("exponential.percentile must be in (0, 100) and exponential.frac positive");
+    }
+  }
+
+  uint64_t Next();
+  uint64_t Last() { return last_.Get(0); }
+
+ private:
+  CounterGenerator &basis_;
+  const double gamma_;
+  ThreadLocalState<uint64_t> last_;
+};
+
+inline uint64_t ExponentialGenerator::Next() {
+  uint64_t max = basis_.Last();
+  utils::Xoshiro256 &rng = utils::ThreadLocalRng();
+  double distance;
+  do {
+    // 1 - u is in (0, 1], so the log is finite
+    distance = -std::log(1.0 - rng.NextDouble()) / gamma_;
+  } while (distance > static_cast<double>(max));
+  return last_.Get(0) = max - static_cast<uint64_t>(distance);
+}
+
+} // ycsbc
+
+#endif // YCSB_C_EXPONENTIAL_GENERATOR_H_
@@ -9,7 +9,10 @@
 #ifndef YCSB_C_GENERATOR_H_
 #define YCSB_C_GENERATOR_H_
 
+#include <atomic>
 #include <cstdint>
+#include <deque>
+#include <utility>
 
 namespace ycsbc {
 
@@ -21,6 +24,43 @@ class Generator {
   virtual ~Generator() { }
 };
 
+///
+/// Mutable state of a generator kept per calling thread, so that client
+/// threads sharing the generator never write to the same memory.
+/// Each instance has an id of its own, never reused, so a thread never picks
+/// up the state of a destroyed generator.
+///
+template <typename State>
+class ThreadLocalState {
+ public:
+  ThreadLocalState() : id_(NextId()) {}
+  ThreadLocalState(const ThreadLocalState &) : id_(NextId()) {}
+  ThreadLocalState &operator=(const ThreadLocalState &) { return *this; }
+
+  ///
+  /// Returns the state of the calling thread, set to init on first use.
+  /// The reference stays valid for the lifetime of the thread.
+  ///
+  State &Get(const State &init) const {
+    static thread_local std::deque<std::pair<uint64_t, State>> states;
+    for (auto &state : states) {
+      if (state.first == id_) {
+        return state.second;
+      }
+    }
+    states.emplace_back(id_, init);
+    return states.back().second;
+  }
+
+ private:
+  static uint64_t NextId() {
+    static std::atomic<uint64_t> next_id{0};
+    return next_id.fetch_add(1);
+  }
+
+  const uint64_t id_;
+};
+
 } // ycsbc
 
 #endif // YCSB_C_GENERATOR_H_
@@ -0,0 +1,70 @@
+//
+//  hotspot_generator.h
+//  YCSB-cpp
+//
+//  Integers with a hot set drawn more often than the rest, like the
+//  HotspotIntegerGenerator of YCSB.
+//
+
+#ifndef YCSB_C_HOTSPOT_GENERATOR_H_
+#define YCSB_C_HOTSPOT_GENERATOR_H_
+
+#include "generator.h"
+
+#include <cstdint>
+#include "utils/utils.h"
+
+namespace ycsbc {
+
+///
+/// Draws from [min, max], where the first hot_set_fraction of the interval
+/// receives hot_op_fraction of the draws, both uniformly within.
+///
+class HotspotGenerator : public Generator<uint64_t> {
+ public:
+  // Both min and max are inclusive
+  HotspotGenerator(uint64_t min, uint64_t max, double hot_set_fraction, double hot_op_fraction);
+
+  uint64_t Next();
+  uint64_t Last() { return last_.Get(min_); }
+
+ private:
+  const uint64_t min_;
+  uint64_t hot_interval_;
+  uint64_t cold_interval_;
+  // hot_op_fraction scaled to 2^64
+  uint64_t hot_threshold_;
+  ThreadLocalState<uint64_t> last_;
+};
+
+inline HotspotGenerator::HotspotGenerator(uint64_t min, uint64_t max, double hot_set_fraction,
+                                          double hot_op_fraction) : min_(min) {
+  if (!(hot_set_fraction >= 0 && hot_set_fraction <= 1)) {
+    throw utils::Exception("hotspotdatafraction must be in [0, 1]");
+  }
+  if (!(hot_op_fraction >= 0 && hot_op_fraction <= 1)) {
+    throw utils::Exception("hotspotopnfraction must be in [0, 1]");
+  }
+  uint64_t interval = max - min + 1;
+  hot_interval_ = static_cast<uint64_t>(interval * hot_set_fraction);
+  cold_interval_ = interval - hot_interval_;
+  if (hot_interval_ == 0) {
+    hot_threshold_ = 0;
+  } else if (hot_op_fraction >= 1) {
+    hot_threshold_ = UINT64_MAX;
+  } else {
+    hot_threshold_ = static_cast<uint64_t>(hot_op_fraction * 0x1.0p64);
+  }
+}
+
+inline uint64_t HotspotGenerator::Next() {
+  utils::Xoshiro256 &rng = utils::ThreadLocalRng();
+  bool hot = rng.Next() < hot_threshold_ || cold_interval_ == 0;
+  uint64_t value = hot ? min_ + rng.NextBelow(hot_interval_)
+                       : min_ + hot_interval_ + rng.NextBelow(cold_interval_);
+  return last_.Get(min_) = value;
+}
+
+} // ycsbc
+
+#endif // YCSB_C_HOTSPOT_GENERATOR_H_
@@ -0,0 +1,83 @@
+//
+//  key_format.cc
+//  YCSB-cpp
+//
+
+#include "key_format.h"
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace ycsbc {
+
+const std::string KeyFormat::FORMAT_PROPERTY = "keyformat";
+const std::string KeyFormat::FORMAT_DEFAULT = "decimal";
+
+const std::string KeyFormat::LENGTH_PROPERTY = "keyformat.length";
+const std::string KeyFormat::LENGTH_DEFAULT = "8";
+
+namespace {
+
+const char kPrefix[] = "user";
+const size_t kPrefixSize = sizeof(kPrefix) - 1;
+const size_t kMaxDigits = 20;
+
+} // anonymous
+
+KeyFormat::KeyFormat(const utils::Properties &p, int zero_padding)
+    : zero_padding_(std::max(zero_padding, 0)) {
+  std::string format = p.GetProperty(FORMAT_PROPERTY, FORMAT_DEFAULT);
+  if (format == "decimal") {
+    type_ = Type::kDecimal;
+  } else if (format == "fixedwidth") {
+    type_ = Type::kFixedWidth;
+    zero_padding_ = kMaxDigits;
+  } else if (format == "binary64") {
+    type_ = Type::kBinary64;
+    length_ = std::stoul(p.GetProperty(LENGTH_PROPERTY, LENGTH_DEFAULT));
+    if (length_ < sizeof(uint64_t)) {
+      throw utils::Exception(LENGTH_PROPERTY + " must be at least 8");
+    }
+  } else {
+    throw utils::Exception("Unknown key format: " + format);
+  }
+}
+
+void KeyFormat::Encode(uint64_t key_num, std::string &key) const {
+  if (type_ == Type::kBinary64) {
+    key.assign(length_ - sizeof(uint64_t), '\0');
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      key.push_back(static_cast<char>(key_num >> shift));
+    }
+    return;
+  }
+  char digits[kMaxDigits];
+  char *end = std::to_chars(digits, digits + kMaxDigits, key_num).ptr;
+  size_t num_digits = end - digits;
+  key.assign(kPrefix, kPrefixSize);
+  if (zero_padding_ > num_digits) {
+    key.append(zero_padding_ - num_digits, '0');
+  }
+  key.append(digits, num_digits);
+}
+
+uint64_t KeyFormat::Decode(const std::string &key) const {
+  uint64_t key_num = 0;
+  if (type_ == Type::kBinary64) {
+    if (key.size() < sizeof(uint64_t)) {
+      throw utils::Exception("Malformed binary key");
+    }
+    for (size_t i = key.size() - sizeof(uint64_t); i < key.size(); i++) {
+      key_num = (key_num << 8) | static_cast<unsigned char>(key[i]);
+    }
+    return key_num;
+  }
+  if (key.size() <= kPrefixSize ||
+      std::from_chars(key.data() + kPrefixSize, key.data() + key.size(), key_num).ec != std::errc()) {
+    throw utils::Exception("Malformed key: " + key);
+  }
+  return key_num;
+}
+
+} // ycsbc
@@ -0,0 +1,66 @@
+//
+//  key_format.h
+//  YCSB-cpp
+//
+//  Encoding of key numbers into the keys handed to the bindings.
+//
+
+#ifndef YCSB_C_KEY_FORMAT_H_
+#define YCSB_C_KEY_FORMAT_H_
+
+#include <cstdint>
+#include <string>
+
+#include "utils/properties.h"
+
+namespace ycsbc {
+
+///
+/// Encodes key numbers as selected by keyformat:
+///  - decimal: "user" followed by the number, zero padded to a minimum width;
+///  - fixedwidth: "user" followed by the number zero padded to 20 digits, so
+///    every key has the same size and keys sort by number;
+///  - binary64: the number as 8 big-endian bytes, preceded by zero bytes up
+///    to keyformat.length, so keys sort by number.
+/// Bindings that store numeric keys use Decode instead of parsing strings.
+///
+class KeyFormat {
+ public:
+  static const std::string FORMAT_PROPERTY;
+  static const std::string FORMAT_DEFAULT;
+
+  ///
+  /// The name of the property for the size of binary64 keys, at least 8.
+  ///
+  static const std::string LENGTH_PROPERTY;
+  static const std::string LENGTH_DEFAULT;
+
+  KeyFormat() = default;
+
+  ///
+  /// zero_padding is the minimum number of digits of decimal keys.
+  ///
+  KeyFormat(const utils::Properties &p, int zero_padding);
+
+  ///
+  /// Replaces the content of key with the key of key_num, keeping its
+  /// capacity, so encoding into a reused buffer does not allocate.
+  ///
+  void Encode(uint64_t key_num, std::string &key) const;
+
+  ///
+  /// Returns the key number of a key produced by Encode.
+  ///
+  uint64_t Decode(const std::string &key) const;
+
+ private:
+  enum class Type { kDecimal, kFixedWidth, kBinary64 };
+
+  Type type_ = Type::kDecimal;
+  size_t zero_padding_ = 1;
+  size_t length_ = 8;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_KEY_FORMAT_H_
@@ -19,6 +19,49 @@ namespace {
 #else
   const std::string MEASUREMENT_TYPE_DEFAULT = "basic";
 #endif
+
+  const std::string MEASUREMENT_SHARDED = "measurement.sharded";
+  const std::string MEASUREMENT_SHARDED_DEFAULT = "false";
+
+  const std::string HDR_INTERVAL = "hdrhistogram.interval";
+  const std::string HDR_INTERVAL_DEFAULT = "false";
+
+  const std::string HDR_INTERVAL_LOG = "hdrhistogram.interval.log";
+  const std::string HDR_INTERVAL_LOG_DEFAULT = "";
+
+  void AppendBasicStatus(std::ostringstream &msg_stream, ycsbc::Operation op, uint64_t cnt,
+                         uint64_t max, uint64_t min, uint64_t sum) {
+    msg_stream << " [" << ycsbc::kOperationString[op] << ":"
+               << " Count=" << cnt
+               << " Max=" << max / 1000.0
+               << " Min=" << min / 1000.0
+               << " Avg=" << ((cnt > 0) ? static_cast<double>(sum) / cnt : 0) / 1000.0
+               << "]";
+  }
+
+#ifdef HDRMEASUREMENT
+  hdr_histogram *NewHistogram() {
+    hdr_histogram *histogram;
+    if (hdr_init(10, 100LL * 1000 * 1000 * 1000, 3, &histogram) != 0) {
+      throw ycsbc::utils::Exception("hdr init failed");
+    }
+    return histogram;
+  }
+
+  void AppendHdrStatus(std::ostringstream &msg_stream, ycsbc::Operation op,
+                       const hdr_histogram *histogram) {
+    msg_stream << " [" << ycsbc::kOperationString[op] << ":"
+               << " Count=" << histogram->total_count
+               << " Max=" << hdr_max(histogram) / 1000.0
+               << " Min=" << hdr_min(histogram) / 1000.0
+               << " Avg=" << hdr_mean(histogram) / 1000.0
+               << " 90=" << hdr_value_at_percentile(histogram, 90) / 1000.0
+               << " 99=" << hdr_value_at_percentile(histogram, 99) / 1000.0
+               << " 99.9=" << hdr_value_at_percentile(histogram, 99.9) / 1000.0
+               << " 99.99=" << hdr_value_at_percentile(histogram, 99.99) / 1000.0
+               << "]";
+  }
+#endif
 } // anonymous
 
 namespace ycsbc {
@@ -48,20 +91,26 @@ std::string BasicMeasurements::GetStatusMsg() {
     uint64_t cnt = count_[op].load(std::memory_order_relaxed);
     if (cnt == 0)
       continue;
-    msg_stream << " [" << kOperationString[op] << ":"
-               << " Count=" << cnt
-               << " Max=" << latency_max_[op].load(std::memory_order_relaxed) / 1000.0
-               << " Min=" << latency_min_[op].load(std::memory_order_relaxed) / 1000.0
-               << " Avg="
-               << ((cnt > 0)
-                   ? static_cast<double>(latency_sum_[op].load(std::memory_order_relaxed)) / cnt
-                   : 0) / 1000.0
-               << "]";
+    AppendBasicStatus(msg_stream, op, cnt,
+                      latency_max_[op].load(std::memory_order_relaxed),
+                      latency_min_[op].load(std::memory_order_relaxed),
+                      latency_sum_[op].load(std::memory_order_relaxed));
     total_cnt += cnt;
   }
   return std::to_string(total_cnt) + msg_stream.str();
 }
 
+LatencySummary BasicMeasurements::Summarize(Operation op, const std::vector<double> &percentiles) {
+  LatencySummary summary{};
+  summary.count = count_[op].load(std::memory_order_relaxed);
+  if (summary.count > 0) {
+    summary.min = latency_min_[op].load(std::memory_order_relaxed);
+    summary.max = latency_max_[op].load(std::memory_order_relaxed);
+    summary.mean = static_cast<double>(latency_sum_[op].load(std::memory_order_relaxed)) / summary.count;
+  }
+  return summary;
+}
+
 void BasicMeasurements::Reset() {
   std::fill(std::begin(count_), std::end(count_), 0);
   std::fill(std::begin(latency_sum_), std::end(latency_sum_), 0);
@@ -69,20 +118,133 @@ void BasicMeasurements::Reset() {
   std::fill(std::begin(latency_max_), std::end(latency_max_), 0);
 }
 
+ShardedBasicMeasurements::Shard::Shard() : epoch(0) {
+  Clear();
+}
+
+void ShardedBasicMeasurements::Shard::Clear() {
+  std::fill(std::begin(count), std::end(count), 0);
+  std::fill(std::begin(latency_sum), std::end(latency_sum), 0);
+  std::fill(std::begin(latency_min), std::end(latency_min), std::numeric_limits<uint64_t>::max());
+  std::fill(std::begin(latency_max), std::end(latency_max), 0);
+}
+
+void ShardedBasicMeasurements::Report(Operation op, uint64_t latency) {
+  Shard &shard = shards_.Local();
+  uint64_t epoch = epoch_.load(std::memory_order_acquire);
+  if (shard.epoch.load(std::memory_order_relaxed) != epoch) {
+    shard.Clear();
+    shard.epoch.store(epoch, std::memory_order_release);
+  }
+  // single writer per shard, so plain loads and stores are enough (no locked RMW)
+  shard.count[op].store(shard.count[op].load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+  shard.latency_sum[op].store(shard.latency_sum[op].load(std::memory_order_relaxed) + latency,
+                              std::memory_order_relaxed);
+  if (latency < shard.latency_min[op].load(std::memory_order_relaxed)) {
+    shard.latency_min[op].store(latency, std::memory_order_relaxed);
+  }
+  if (latency > shard.latency_max[op].load(std::memory_order_relaxed)) {
+    shard.latency_max[op].store(latency, std::memory_order_relaxed);
+  }
+}
+
+std::string ShardedBasicMeasurements::GetStatusMsg() {
+  uint64_t count[MAXOPTYPE] = {};
+  uint64_t latency_sum[MAXOPTYPE] = {};
+  uint64_t latency_max[MAXOPTYPE] = {};
+  uint64_t latency_min[MAXOPTYPE];
+  std::fill(std::begin(latency_min), std::end(latency_min), std::numeric_limits<uint64_t>::max());
+  uint64_t epoch = epoch_.load(std::memory_order_acquire);
+  shards_.ForEach([&](Shard &shard) {
+    if (shard.epoch.load(std::memory_order_acquire) != epoch) {
+      return;
+    }
+    for (int op = 0; op < MAXOPTYPE; op++) {
+      count[op] += shard.count[op].load(std::memory_order_relaxed);
+      latency_sum[op] += shard.latency_sum[op].load(std::memory_order_relaxed);
+      latency_min[op] = std::min(latency_min[op], shard.latency_min[op].load(std::memory_order_relaxed));
+      latency_max[op] = std::max(latency_max[op], shard.latency_max[op].load(std::memory_order_relaxed));
+    }
+  });
+
+  std::ostringstream msg_stream;
+  msg_stream.precision(2);
+  uint64_t total_cnt = 0;
+  msg_stream << std::fixed << " operations;";
+  for (int i = 0; i < MAXOPTYPE; i++) {
+    Operation op = static_cast<Operation>(i);
+    if (count[op] == 0)
+      continue;
+    AppendBasicStatus(msg_stream, op, count[op], latency_max[op], latency_min[op], latency_sum[op]);
+    total_cnt += count[op];
+  }
+  return std::to_string(total_cnt) + msg_stream.str();
+}
+
+LatencySummary ShardedBasicMeasurements::Summarize(Operation op,
+                                                   const std::vector<double> &percentiles) {
+  LatencySummary summary{};
+  uint64_t latency_sum = 0;
+  summary.min = std::numeric_limits<uint64_t>::max();
+  uint64_t epoch = epoch_.load(std::memory_order_acquire);
+  shards_.ForEach([&](Shard &shard) {
+    if (shard.epoch.load(std::memory_order_acquire) != epoch) {
+      return;
+    }
+    summary.count += shard.count[op].load(std::memory_order_relaxed);
+    latency_sum += shard.latency_sum[op].load(std::memory_order_relaxed);
+    summary.min = std::min(summary.min, shard.latency_min[op].load(std::memory_order_relaxed));
+    summary.max = std::max(summary.max, shard.latency_max[op].load(std::memory_order_relaxed));
+  });
+  if (summary.count > 0) {
+    summary.mean = static_cast<double>(latency_sum) / summary.count;
+  } else {
+    summary.min = 0;
+  }
+  return summary;
+}
+
+void ShardedBasicMeasurements::Reset() {
+  epoch_.fetch_add(1, std::memory_order_acq_rel);
+}
+
 #ifdef HDRMEASUREMENT
-HdrHistogramMeasurements::HdrHistogramMeasurements() {
+HdrHistogramMeasurementsBase::HdrHistogramMeasurementsBase(bool interval,
+                                                           const std::string &log_prefix)
+    : interval_(interval), log_prefix_(log_prefix), interval_histogram_{}, log_file_{} {
   for (int op = 0; op < MAXOPTYPE; op++) {
-    if (hdr_init(10, 100LL * 1000 * 1000 * 1000, 3, &histogram_[op]) != 0) {
-      utils::Exception("hdr init failed");
+    histogram_[op] = NewHistogram();
+    if (interval_) {
+      interval_histogram_[op] = NewHistogram();
     }
   }
+  hdr_log_writer_init(&log_writer_);
+  hdr_gettime(&interval_start_);
+  interval_clock_ = std::chrono::steady_clock::now();
 }
 
-void HdrHistogramMeasurements::Report(Operation op, uint64_t latency) {
-  hdr_record_value_atomic(histogram_[op], latency);
+HdrHistogramMeasurementsBase::~HdrHistogramMeasurementsBase() {
+  for (int op = 0; op < MAXOPTYPE; op++) {
+    hdr_close(histogram_[op]);
+    hdr_close(interval_histogram_[op]);
+    if (log_file_[op] != nullptr) {
+      std::fclose(log_file_[op]);
+    }
+  }
 }
 
-std::string HdrHistogramMeasurements::GetStatusMsg() {
+void HdrHistogramMeasurementsBase::Fold(Operation op, const hdr_histogram *sample) {
+  hdr_add(histogram_[op], sample);
+  if (interval_) {
+    hdr_add(interval_histogram_[op], sample);
+  }
+}
+
+std::string HdrHistogramMeasurementsBase::GetStatusMsg() {
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  Collect();
+
   std::ostringstream msg_stream;
   msg_stream.precision(2);
   uint64_t total_cnt = 0;
@@ -90,39 +252,236 @@ std::string HdrHistogramMeasurements::GetStatusMsg() {
   for (int i = 0; i < MAXOPTYPE; i++) {
     Operation op = static_cast<Operation>(i);
     uint64_t cnt = histogram_[op]->total_count;
+    if (cnt == 0)
+      continue;
+    AppendHdrStatus(msg_stream, op, histogram_[op]);
+    total_cnt += cnt;
+  }
+  return std::to_string(total_cnt) + msg_stream.str();
+}
+
+LatencySummary HdrHistogramMeasurementsBase::Summarize(Operation op,
+                                                       const std::vector<double> &percentiles) {
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  Collect();
+
+  const hdr_histogram *histogram = histogram_[op];
+  LatencySummary summary{};
+  summary.count = histogram->total_count;
+  if (summary.count > 0) {
+    summary.min = hdr_min(histogram);
+    summary.max = hdr_max(histogram);
+    summary.mean = hdr_mean(histogram);
+  }
+  for (double p : percentiles) {
+    summary.percentiles.emplace_back(p, hdr_value_at_percentile(histogram, p));
+  }
+  return summary;
+}
+
+std::string HdrHistogramMeasurementsBase::GetIntervalMsg() {
+  if (!interval_) {
+    return "";
+  }
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  Collect();
+
+  auto now = std::chrono::steady_clock::now();
+  double elapsed = std::chrono::duration<double>(now - interval_clock_).count();
+
+  std::ostringstream msg_stream;
+  msg_stream.precision(2);
+  uint64_t total_cnt = 0;
+  msg_stream << std::fixed;
+  for (int i = 0; i < MAXOPTYPE; i++) {
+    Operation op = static_cast<Operation>(i);
+    const hdr_histogram *histogram = interval_histogram_[op];
+    uint64_t cnt = histogram->total_count;
     if (cnt == 0)
       continue;
     msg_stream << " [" << kOperationString[op] << ":"
                << " Count=" << cnt
-               << " Max=" << hdr_max(histogram_[op]) / 1000.0
-               << " Min=" << hdr_min(histogram_[op]) / 1000.0
-               << " Avg=" << hdr_mean(histogram_[op]) / 1000.0
-               << " 90=" << hdr_value_at_percentile(histogram_[op], 90) / 1000.0
-               << " 99=" << hdr_value_at_percentile(histogram_[op], 99) / 1000.0
-               << " 99.9=" << hdr_value_at_percentile(histogram_[op], 99.9) / 1000.0
-               << " 99.99=" << hdr_value_at_percentile(histogram_[op], 99.99) / 1000.0
+               << " Max=" << hdr_max(histogram) / 1000.0
+               << " Min=" << hdr_min(histogram) / 1000.0
+               << " Avg=" << hdr_mean(histogram) / 1000.0
+               << " 50=" << hdr_value_at_percentile(histogram, 50) / 1000.0
+               << " 99=" << hdr_value_at_percentile(histogram, 99) / 1000.0
+               << " 99.9=" << hdr_value_at_percentile(histogram, 99.9) / 1000.0
                << "]";
     total_cnt += cnt;
   }
-  return std::to_string(total_cnt) + msg_stream.str();
+  std::ostringstream head_stream;
+  head_stream.precision(2);
+  head_stream << std::fixed << total_cnt << " operations; "
+              << (elapsed > 0 ? total_cnt / elapsed : 0) << " current ops/sec;";
+
+  if (!log_prefix_.empty()) {
+    WriteIntervalLog();
+  }
+  for (int op = 0; op < MAXOPTYPE; op++) {
+    hdr_reset(interval_histogram_[op]);
+  }
+  interval_clock_ = now;
+  return head_stream.str() + msg_stream.str();
+}
+
+void HdrHistogramMeasurementsBase::WriteIntervalLog() {
+  hdr_timespec interval_end;
+  hdr_gettime(&interval_end);
+  for (int op = 0; op < MAXOPTYPE; op++) {
+    if (log_file_[op] == nullptr) {
+      // start the log of an operation at its first recorded interval
+      if (interval_histogram_[op]->total_count == 0) {
+        continue;
+      }
+      std::string path = log_prefix_ + kOperationString[op] + ".hlog";
+      log_file_[op] = std::fopen(path.c_str(), "w");
+      if (log_file_[op] == nullptr) {
+        throw utils::Exception("failed to open: " + path);
+      }
+      hdr_log_write_header(&log_writer_, log_file_[op], kOperationString[op], &interval_start_);
+    }
+    hdr_log_write(&log_writer_, log_file_[op], &interval_start_, &interval_end,
+                  interval_histogram_[op]);
+    std::fflush(log_file_[op]);
+  }
+  interval_start_ = interval_end;
 }
 
-void HdrHistogramMeasurements::Reset() {
+void HdrHistogramMeasurementsBase::Reset() {
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  Collect();
   for (int op = 0; op < MAXOPTYPE; op++) {
     hdr_reset(histogram_[op]);
+    if (interval_) {
+      hdr_reset(interval_histogram_[op]);
+    }
+  }
+  hdr_gettime(&interval_start_);
+  interval_clock_ = std::chrono::steady_clock::now();
+}
+
+HdrHistogramMeasurements::HdrHistogramMeasurements(bool interval, const std::string &log_prefix)
+    : HdrHistogramMeasurementsBase(interval, log_prefix), recycled_{} {
+  if (interval_) {
+    for (int op = 0; op < MAXOPTYPE; op++) {
+      if (hdr_interval_recorder_init_all(&recorder_[op], 10, 100LL * 1000 * 1000 * 1000, 3) != 0) {
+        throw utils::Exception("hdr interval recorder init failed");
+      }
+    }
   }
 }
+
+HdrHistogramMeasurements::~HdrHistogramMeasurements() {
+  if (interval_) {
+    for (int op = 0; op < MAXOPTYPE; op++) {
+      hdr_close(recycled_[op]);
+      hdr_interval_recorder_destroy(&recorder_[op]);
+    }
+  }
+}
+
+void HdrHistogramMeasurements::Report(Operation op, uint64_t latency) {
+  if (interval_) {
+    hdr_interval_recorder_record_value_atomic(&recorder_[op], latency);
+  } else {
+    hdr_record_value_atomic(histogram_[op], latency);
+  }
+}
+
+void HdrHistogramMeasurements::Collect() {
+  if (!interval_) {
+    // values are recorded into the cumulative histograms directly
+    return;
+  }
+  for (int i = 0; i < MAXOPTYPE; i++) {
+    Operation op = static_cast<Operation>(i);
+    recycled_[op] = hdr_interval_recorder_sample_and_recycle(&recorder_[op], recycled_[op]);
+    Fold(op, recycled_[op]);
+  }
+}
+
+ShardedHdrHistogramMeasurements::Shard::Shard() : active{}, spare{} {}
+
+ShardedHdrHistogramMeasurements::Shard::~Shard() {
+  for (int op = 0; op < MAXOPTYPE; op++) {
+    hdr_close(active[op]);
+    hdr_close(spare[op]);
+  }
+}
+
+void ShardedHdrHistogramMeasurements::Report(Operation op, uint64_t latency) {
+  Shard &shard = shards_.Local();
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.active[op] == nullptr) {
+    shard.active[op] = NewHistogram();
+  }
+  hdr_record_value(shard.active[op], latency);
+}
+
+void ShardedHdrHistogramMeasurements::Collect() {
+  shards_.ForEach([this](Shard &shard) {
+    // active is the owner's, so it is only looked at with the lock held, and
+    // the spares are allocated outside of it
+    bool recorded[MAXOPTYPE];
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      for (int op = 0; op < MAXOPTYPE; op++) {
+        recorded[op] = shard.active[op] != nullptr;
+      }
+    }
+    for (int op = 0; op < MAXOPTYPE; op++) {
+      if (recorded[op] && shard.spare[op] == nullptr) {
+        shard.spare[op] = NewHistogram();
+      }
+    }
+    {
+      // swap the buffers only, merging is done outside of the owner's way
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      for (int op = 0; op < MAXOPTYPE; op++) {
+        if (shard.spare[op] != nullptr) {
+          std::swap(shard.active[op], shard.spare[op]);
+        }
+      }
+    }
+    for (int i = 0; i < MAXOPTYPE; i++) {
+      Operation op = static_cast<Operation>(i);
+      if (shard.spare[op] != nullptr) {
+        Fold(op, shard.spare[op]);
+        hdr_reset(shard.spare[op]);
+      }
+    }
+  });
+}
 #endif
 
-Measurements *CreateMeasurements(utils::Properties *props) {
+Measurements *CreateMeasurements(utils::Properties *props, const std::string &log_label) {
   std::string name = props->GetProperty(MEASUREMENT_TYPE, MEASUREMENT_TYPE_DEFAULT);
+  // per-thread recorders merged on read, instead of shared atomics
+  const bool sharded = utils::StrToBool(props->GetProperty(MEASUREMENT_SHARDED,
+                                                           MEASUREMENT_SHARDED_DEFAULT));
 
   Measurements *measurements;
   if (name == "basic") {
-    measurements = new BasicMeasurements();
+    if (sharded) {
+      measurements = new ShardedBasicMeasurements();
+    } else {
+      measurements = new BasicMeasurements();
+    }
 #ifdef HDRMEASUREMENT
   } else if (name == "hdrhistogram") {
-    measurements = new HdrHistogramMeasurements();
+    // per status interval histograms, optionally logged to <prefix><OPERATION>.hlog
+    std::string log_prefix = props->GetProperty(HDR_INTERVAL_LOG, HDR_INTERVAL_LOG_DEFAULT);
+    const bool interval = utils::StrToBool(props->GetProperty(HDR_INTERVAL, HDR_INTERVAL_DEFAULT))
+                          || !log_prefix.empty();
+    if (!log_prefix.empty()) {
+      log_prefix += log_label;
+    }
+    if (sharded) {
+      measurements = new ShardedHdrHistogramMeasurements(interval, log_prefix);
+    } else {
+      measurements = new HdrHistogramMeasurements(interval, log_prefix);
+    }
 #endif
   } else {
     measurements = nullptr;
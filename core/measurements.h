@@ -12,19 +12,46 @@
 #include "utils/properties.h"
 
 #include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #ifdef HDRMEASUREMENT
 #include <hdr/hdr_histogram.h>
+#include <hdr/hdr_histogram_log.h>
+#include <hdr/hdr_interval_recorder.h>
+#include <hdr/hdr_time.h>
 #endif
 
 typedef unsigned int uint;
 
 namespace ycsbc {
 
+///
+/// Latency statistics of one operation type, in nanoseconds.
+///
+struct LatencySummary {
+  uint64_t count;
+  uint64_t min;
+  uint64_t max;
+  double mean;
+  /// (percentile, value) pairs, empty if the measurements do not track percentiles
+  std::vector<std::pair<double, uint64_t>> percentiles;
+};
+
 class Measurements {
  public:
+  virtual ~Measurements() = default;
   virtual void Report(Operation op, uint64_t latency) = 0;
   virtual std::string GetStatusMsg() = 0;
+  virtual LatencySummary Summarize(Operation op, const std::vector<double> &percentiles) = 0;
+  ///
+  /// Returns the stats of the operations recorded since the previous call,
+  /// or an empty string if the measurements do not report per interval.
+  ///
+  virtual std::string GetIntervalMsg() { return ""; }
   virtual void Reset() = 0;
 };
 
@@ -33,6 +60,7 @@ class BasicMeasurements : public Measurements {
   BasicMeasurements();
   void Report(Operation op, uint64_t latency) override;
   std::string GetStatusMsg() override;
+  LatencySummary Summarize(Operation op, const std::vector<double> &percentiles) override;
   void Reset() override;
  private:
   std::atomic<uint> count_[MAXOPTYPE];
@@ -41,19 +69,190 @@ class BasicMeasurements : public Measurements {
   std::atomic<uint64_t> latency_max_[MAXOPTYPE];
 };
 
-#ifdef HDRMEASUREMENT
-class HdrHistogramMeasurements : public Measurements {
+///
+/// Set of per-thread shards used by the sharded measurements.
+/// Each thread is handed a shard of its own on first use, so recording never
+/// touches a cache line written by another client thread. When a thread exits
+/// its shard goes back to the set (data kept) and is reused by the next thread.
+///
+template <typename Shard>
+class ShardSet {
+ public:
+  ShardSet() : id_(next_id_.fetch_add(1)), registry_(std::make_shared<Registry>()) {}
+
+  Shard &Local();
+
+  ///
+  /// Calls func on every shard, including the ones of exited threads.
+  ///
+  template <typename Func>
+  void ForEach(Func func);
+
+ private:
+  struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<Shard *> idle;
+  };
+
+  // thread-local handle returning the shard to its set when the thread exits
+  struct Lease {
+    Lease(uint64_t id, std::weak_ptr<Registry> registry, Shard *shard)
+        : id(id), registry(std::move(registry)), shard(shard) {}
+    Lease(Lease &&) = default;
+    Lease(const Lease &) = delete;
+    ~Lease();
+
+    uint64_t id;
+    std::weak_ptr<Registry> registry;
+    Shard *shard;
+  };
+
+  Shard *Acquire();
+
+  static inline std::atomic<uint64_t> next_id_{0};
+  const uint64_t id_;
+  std::shared_ptr<Registry> registry_;
+};
+
+template <typename Shard>
+inline Shard &ShardSet<Shard>::Local() {
+  static thread_local std::vector<Lease> leases;
+  for (const Lease &lease : leases) {
+    if (lease.id == id_) {
+      return *lease.shard;
+    }
+  }
+  leases.emplace_back(id_, registry_, Acquire());
+  return *leases.back().shard;
+}
+
+template <typename Shard>
+template <typename Func>
+inline void ShardSet<Shard>::ForEach(Func func) {
+  std::lock_guard<std::mutex> lock(registry_->mutex);
+  for (auto &shard : registry_->shards) {
+    func(*shard);
+  }
+}
+
+template <typename Shard>
+inline Shard *ShardSet<Shard>::Acquire() {
+  std::lock_guard<std::mutex> lock(registry_->mutex);
+  if (!registry_->idle.empty()) {
+    Shard *shard = registry_->idle.back();
+    registry_->idle.pop_back();
+    return shard;
+  }
+  registry_->shards.push_back(std::make_unique<Shard>());
+  return registry_->shards.back().get();
+}
+
+template <typename Shard>
+inline ShardSet<Shard>::Lease::~Lease() {
+  std::shared_ptr<Registry> owner = registry.lock();
+  if (owner) {
+    std::lock_guard<std::mutex> lock(owner->mutex);
+    owner->idle.push_back(shard);
+  }
+}
+
+class ShardedBasicMeasurements : public Measurements {
  public:
-  HdrHistogramMeasurements();
   void Report(Operation op, uint64_t latency) override;
   std::string GetStatusMsg() override;
+  LatencySummary Summarize(Operation op, const std::vector<double> &percentiles) override;
   void Reset() override;
  private:
+  struct alignas(64) Shard {
+    Shard();
+    void Clear();
+    // written by the owning thread only, read by the status thread
+    std::atomic<uint64_t> count[MAXOPTYPE];
+    std::atomic<uint64_t> latency_sum[MAXOPTYPE];
+    std::atomic<uint64_t> latency_min[MAXOPTYPE];
+    std::atomic<uint64_t> latency_max[MAXOPTYPE];
+    // the Reset() the values count from
+    std::atomic<uint64_t> epoch;
+  };
+  ShardSet<Shard> shards_;
+  // Reset() only starts a new epoch, each owner clears its shard on its next
+  // Report() and readers skip the shards still in an older epoch
+  std::atomic<uint64_t> epoch_{0};
+};
+
+#ifdef HDRMEASUREMENT
+///
+/// Common part of the HdrHistogram measurements.
+/// Holds the cumulative histograms and, with interval reporting enabled, the
+/// histograms of the current status interval. Subclasses hand recorded values
+/// over in Collect(), which is always called with collect_mutex_ held.
+///
+class HdrHistogramMeasurementsBase : public Measurements {
+ public:
+  HdrHistogramMeasurementsBase(bool interval, const std::string &log_prefix);
+  ~HdrHistogramMeasurementsBase();
+  std::string GetStatusMsg() override;
+  LatencySummary Summarize(Operation op, const std::vector<double> &percentiles) override;
+  std::string GetIntervalMsg() override;
+  void Reset() override;
+ protected:
+  virtual void Collect() = 0;
+  void Fold(Operation op, const hdr_histogram *sample);
+  void WriteIntervalLog();
+
+  const bool interval_;
+  const std::string log_prefix_;
   hdr_histogram *histogram_[MAXOPTYPE];
+  hdr_histogram *interval_histogram_[MAXOPTYPE];
+  std::FILE *log_file_[MAXOPTYPE];
+  hdr_log_writer log_writer_;
+  hdr_timespec interval_start_;
+  std::chrono::steady_clock::time_point interval_clock_;
+  std::mutex collect_mutex_;
+};
+
+class HdrHistogramMeasurements : public HdrHistogramMeasurementsBase {
+ public:
+  HdrHistogramMeasurements(bool interval, const std::string &log_prefix);
+  ~HdrHistogramMeasurements();
+  void Report(Operation op, uint64_t latency) override;
+ protected:
+  void Collect() override;
+ private:
+  // double-buffered recorders, only used with interval reporting
+  hdr_interval_recorder recorder_[MAXOPTYPE];
+  hdr_histogram *recycled_[MAXOPTYPE];
+};
+
+class ShardedHdrHistogramMeasurements : public HdrHistogramMeasurementsBase {
+ public:
+  ShardedHdrHistogramMeasurements(bool interval, const std::string &log_prefix)
+      : HdrHistogramMeasurementsBase(interval, log_prefix) {}
+  void Report(Operation op, uint64_t latency) override;
+ protected:
+  void Collect() override;
+ private:
+  struct alignas(64) Shard {
+    Shard();
+    ~Shard();
+    // guards against the status thread swapping buffers while the owner records
+    std::mutex mutex;
+    // allocated on first record of the operation
+    hdr_histogram *active[MAXOPTYPE];
+    // swapped with active on Collect, touched by the collecting thread only
+    hdr_histogram *spare[MAXOPTYPE];
+  };
+  ShardSet<Shard> shards_;
 };
 #endif
 
-Measurements *CreateMeasurements(utils::Properties *props);
+///
+/// Creates the measurements selected by measurementtype.
+/// log_label is inserted into the names of the histogram log files, so that
+/// several measurements can log side by side.
+///
+Measurements *CreateMeasurements(utils::Properties *props, const std::string &log_label = "");
 
 } // ycsbc
 
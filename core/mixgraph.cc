@@ -2,29 +2,36 @@
 #include "workload_factory.h"
 #include "two_term_exp_generator.h"
 #include "pareto_generator.h"
-#include "random_byte_generator.h"
+#include "random_byte_pool.h"
 #include "uniform_generator.h"
+#include "utils/random.h"
+#include "utils/utils.h"
 
-static std::string build_key(uint64_t key_num, size_t key_size) {
-    std::string key_suf = std::to_string(key_num);
-    std::string key_pre(key_size > key_suf.size() + 4 ? key_size - key_suf.size() - 4 : 0, '0');
-    return "user" + std::move(key_pre) + std::move(key_suf);
+#include <algorithm>
+#include <cmath>
+
+// encodes into the key buffer of the calling thread, so keys do not allocate
+const std::string &ycsbc::MixGraph::build_key(uint64_t key_num) {
+    static thread_local std::string key;
+    key_format.Encode(key_num, key);
+    return key;
 }
 
-static std::vector<ycsbc::DB::Field> build_values(uint64_t value_size) {
-    ycsbc::DB::Field field;
+// refills the value vector of the calling thread, so inserts do not allocate
+static std::vector<ycsbc::DB::Field> &build_values(uint64_t value_size) {
+    static thread_local std::vector<ycsbc::DB::Field> values(1);
+    ycsbc::DB::Field &field = values[0];
     field.name = "VF";
     size_t nfill = value_size > 8 + 2 ? value_size - 8 - 2 : 0;
-    field.value.resize(nfill);
-    ycsbc::RandomByteGenerator byte_gen;
-    std::generate_n(field.value.begin(), nfill, [&byte_gen]() { return byte_gen.Next(); });
-    return {field};
+    ycsbc::RandomBytePool::Fill(field.value, nfill);
+    return values;
 }
 
 void ycsbc::MixGraph::Init(const utils::Properties &p) {
-    double read_proportion = std::stod(p.GetProperty("readproportion", "1"));
-    double insert_proportion = std::stod(p.GetProperty("insertproportion", "0"));
-    double scan_proportion = std::stod(p.GetProperty("scanproportion", "0"));
+    // db_bench's Get/Put/Seek ratios, or the YCSB proportions without them
+    double read_proportion = std::stod(p.GetProperty("mix_get_ratio", p.GetProperty("readproportion", "1")));
+    double insert_proportion = std::stod(p.GetProperty("mix_put_ratio", p.GetProperty("insertproportion", "0")));
+    double scan_proportion = std::stod(p.GetProperty("mix_seek_ratio", p.GetProperty("scanproportion", "0")));
     if (read_proportion > 0)
         op_gen.AddValue(READ, read_proportion);
     if (insert_proportion > 0)
@@ -57,20 +64,51 @@ void ycsbc::MixGraph::Init(const utils::Properties &p) {
     scan_len_gen = std::make_unique<ParetoGenerator>(scan_len_theta, scan_len_k, scan_len_sigma);
     
     key_size = std::stoull(p.GetProperty("keysize", "16"));
+    // decimal keys are padded to keysize bytes
+    key_format = KeyFormat(p, key_size > 4 ? key_size - 4 : 0);
     insert_value_size = std::stoull(p.GetProperty("insert_valuesize", "100"));
-    valuesize_max = std::stoull(p.GetProperty("valuesize_max", "1024"));
-    scanlen_max = std::stoull(p.GetProperty("scanlen_max", "10000"));
+    valuesize_max = std::stoull(p.GetProperty("mix_max_value_size", p.GetProperty("valuesize_max", "1024")));
+    scanlen_max = std::stoull(p.GetProperty("mix_max_scan_len", p.GetProperty("scanlen_max", "10000")));
+    if (valuesize_max == 0 || scanlen_max == 0)
+        throw utils::Exception("mix_max_value_size and mix_max_scan_len must be positive");
     
+    // as db_bench, the rate only varies with sine_mix_rate=true
+    sine_mix_rate = utils::StrToBool(p.GetProperty("sine_mix_rate", "false"));
+    sine_interval_ms = std::stoi(p.GetProperty("sine_mix_rate_interval_milliseconds", "10000"));
+    sine_a = std::stod(p.GetProperty("sine_a", "1"));
+    sine_b = std::stod(p.GetProperty("sine_b", "1"));
+    sine_c = std::stod(p.GetProperty("sine_c", "0"));
+    sine_d = std::stod(p.GetProperty("sine_d", "1"));
+    sine_noise = std::stod(p.GetProperty("sine_mix_rate_noise", "0"));
+    if (sine_mix_rate && sine_interval_ms <= 0)
+        throw utils::Exception("sine_mix_rate_interval_milliseconds must be positive");
+
     table_name = p.GetProperty("table", "usertable");
+
+    RandomBytePool::SetCompressibility(std::stod(p.GetProperty("value.compressibility", "1.0")));
 }
 
 bool ycsbc::MixGraph::DoInsert(DB &db) {
-    std::string key = build_key(insert_key_gen->Next(), key_size);
-    std::vector<DB::Field> values = build_values(insert_value_size);
+    const std::string &key = build_key(insert_key_gen->Next());
+    std::vector<DB::Field> &values = build_values(insert_value_size);
     auto status = db.Insert(table_name, key, values);
     return status == DB::kOK;
 }
 
+int ycsbc::MixGraph::RateInterval() const {
+    return sine_mix_rate ? sine_interval_ms : 0;
+}
+
+double ycsbc::MixGraph::TargetRate(double seconds) {
+    double rate = sine_a * std::sin(sine_b * seconds + sine_c) + sine_d;
+    // db_bench adds uniform noise of up to sine_mix_rate_noise times the rate
+    if (sine_noise > 0 && sine_noise <= 1) {
+        double band = rate * sine_noise;
+        rate += (2 * utils::ThreadLocalRng().NextDouble() - 1) * band;
+    }
+    return rate;
+}
+
 bool ycsbc::MixGraph::DoTransaction(DB &db) {
     switch (op_gen.Next()) {
         case READ:
@@ -85,23 +123,29 @@ bool ycsbc::MixGraph::DoTransaction(DB &db) {
 }
 
 bool ycsbc::MixGraph::TransactionRead(DB &db) {
-    std::string key = build_key(key_gen->Next(), key_size);
+    const std::string &key = build_key(key_gen->Next());
     std::vector<DB::Field> result;
     auto status = db.Read(table_name, key, nullptr, result);
     return status == DB::kOK;
 }
 
 bool ycsbc::MixGraph::TransactionInsert(DB &db) {
-    std::string key = build_key(key_gen->Next(), key_size);
-    uint64_t value_size = std::min(value_size_gen->Next(), valuesize_max);
-    std::vector<DB::Field> values = build_values(value_size);
+    const std::string &key = build_key(key_gen->Next());
+    // as db_bench, small values are raised to 10 bytes and large ones wrap around the max
+    uint64_t value_size = value_size_gen->Next();
+    if (value_size < 10)
+        value_size = 10;
+    else if (value_size > valuesize_max)
+        value_size %= valuesize_max;
+    std::vector<DB::Field> &values = build_values(value_size);
     auto status = db.Insert(table_name, key, values);
     return status == DB::kOK;
 }
 
+// a db_bench seek, Seek() to the key then Next() over scan_len records
 bool ycsbc::MixGraph::TransactionScan(DB &db) {
-    std::string key = build_key(key_gen->Next(), key_size);
-    size_t scan_len = std::min(scan_len_gen->Next(), scanlen_max);
+    const std::string &key = build_key(key_gen->Next());
+    size_t scan_len = scan_len_gen->Next() % scanlen_max;
     std::vector<std::vector<DB::Field>> result;
     auto status = db.Scan(table_name, key, scan_len, nullptr, result);
     return status == DB::kOK;
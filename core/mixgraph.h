@@ -1,10 +1,12 @@
 #ifndef YCSB_C_MIXGRAPH_H_
 #define YCSB_C_MIXGRAPH_H_
+#include <memory>
 #include <vector>
 
 #include "workload.h"
 #include "discrete_generator.h"
 #include "generator.h"
+#include "key_format.h"
 
 namespace ycsbc {
 
@@ -14,10 +16,13 @@ class MixGraph: public Workload {
         virtual void Init(const utils::Properties &p) override;
         virtual bool DoInsert(DB &db) override;
         virtual bool DoTransaction(DB &db) override;
+        virtual int RateInterval() const override;
+        virtual double TargetRate(double seconds) override;
     protected:
         bool TransactionRead(DB &db);
         bool TransactionInsert(DB &db);
         bool TransactionScan(DB &db);
+        const std::string &build_key(uint64_t key_num);
     private:
         DiscreteGenerator<Operation> op_gen;
         std::unique_ptr<Generator<uint64_t>> insert_key_gen;
@@ -26,10 +31,20 @@ class MixGraph: public Workload {
         std::unique_ptr<Generator<uint64_t>> scan_len_gen;
 
         size_t key_size;
+        KeyFormat key_format;
         size_t insert_value_size;
         size_t valuesize_max;
         size_t scanlen_max;
 
+        // request rate of db_bench's sine_mix_rate, a * sin(b * t + c) + d
+        bool sine_mix_rate;
+        int sine_interval_ms;
+        double sine_a;
+        double sine_b;
+        double sine_c;
+        double sine_d;
+        double sine_noise;
+
         std::string table_name;
 };
 
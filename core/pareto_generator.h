@@ -1,8 +1,9 @@
 #ifndef YCSB_C_PARETO_GENERATOR_H_
 #define YCSB_C_PARETO_GENERATOR_H_
-#include <random>
+#include <cmath>
 
 #include "generator.h"
+#include "utils/utils.h"
 
 namespace ycsbc {
 
@@ -17,20 +18,19 @@ class ParetoGenerator : public Generator<uint64_t> {
         virtual ~ParetoGenerator() = default;
 
         uint64_t Next() override {
-            last = ceil(m_theta + m_sigma * (pow(dist(gen), -m_k) - 1) * k_rec);
-            return last;
+            // u in (0, 1], as pow(0, -k) is infinite
+            double u = 1.0 - utils::ThreadLocalRng().NextDouble();
+            return last.Get(0) = ceil(m_theta + m_sigma * (pow(u, -m_k) - 1) * k_rec);
         }
-        uint64_t Last() override { return last; }
+        uint64_t Last() override { return last.Get(0); }
 
     private:
-        std::mt19937_64 gen;
-        std::uniform_real_distribution<double> dist;
         double m_theta;
         double m_k;
         double m_sigma;
         double k_rec;
 
-        uint64_t last;
+        ThreadLocalState<uint64_t> last;
 };
 
 }
@@ -0,0 +1,120 @@
+//
+//  random_byte_pool.h
+//  YCSB-cpp
+//
+//  Pre-generated random bytes that field values are cut from.
+//
+
+#ifndef YCSB_C_RANDOM_BYTE_POOL_H_
+#define YCSB_C_RANDOM_BYTE_POOL_H_
+
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+namespace ycsbc {
+
+///
+/// Per-thread pool of random bytes generated once, on first use.
+/// A value is copied from a random offset of the pool instead of being
+/// generated byte by byte, like the value generator of db_bench.
+///
+class RandomBytePool {
+ public:
+  static const size_t kSize = 1 << 20;
+  static const size_t kChunk = 100;
+  /// compressed bytes per random printable byte, log2(95) / 8
+  static constexpr double kLiteralRatio = 0.82;
+  /// compressed bytes of the back-reference repeating the piece in a chunk
+  static constexpr double kMatchBytes = 3;
+
+  ///
+  /// Sets the compressibility of the pools generated afterwards, as the target
+  /// ratio of compressed to raw size in (0, 1]. Each kChunk bytes of the pool
+  /// repeat a random piece sized so that the piece plus one back-reference
+  /// compress to ratio * kChunk bytes (zlib: 0.25, 0.5 and 0.75 measure within
+  /// 0.02). Printable bytes entropy-code to kLiteralRatio, so targets above
+  /// about 0.83 all give fully random bytes.
+  ///
+  static void SetCompressibility(double ratio);
+
+  ///
+  /// Replaces the content of value with len bytes of the calling thread's pool.
+  /// The capacity of value is kept, so refilling a value does not allocate.
+  ///
+  static void Fill(std::string &value, size_t len);
+
+ private:
+  static const std::string &Local();
+  static std::string Generate(double ratio);
+  static void AppendRandom(std::string &bytes, size_t len);
+
+  static inline std::atomic<double> compressibility_{1.0};
+};
+
+inline void RandomBytePool::SetCompressibility(double ratio) {
+  if (!(ratio > 0 && ratio <= 1)) {
+    throw utils::Exception("value.compressibility must be in (0, 1]");
+  }
+  compressibility_ = ratio;
+}
+
+inline const std::string &RandomBytePool::Local() {
+  static thread_local const std::string pool = Generate(compressibility_);
+  return pool;
+}
+
+inline void RandomBytePool::AppendRandom(std::string &bytes, size_t len) {
+  // printable bytes, 8 per random word, drawn in batches
+  uint64_t words[64];
+  utils::Xoshiro256 &rng = utils::ThreadLocalRng();
+  while (len > 0) {
+    size_t n = std::min<size_t>(64, (len + 7) / 8);
+    rng.Fill(words, n);
+    for (size_t i = 0; i < n && len > 0; i++) {
+      for (int b = 0; b < 8 && len > 0; b++, len--) {
+        bytes.push_back(static_cast<char>(' ' + ((words[i] >> (8 * b)) & 0xff) % 95));
+      }
+    }
+  }
+}
+
+inline std::string RandomBytePool::Generate(double ratio) {
+  std::string bytes;
+  bytes.reserve(kSize);
+  const double raw_len = (kChunk * ratio - kMatchBytes) / kLiteralRatio;
+  if (raw_len >= kChunk) {
+    AppendRandom(bytes, kSize);
+    return bytes;
+  }
+
+  const size_t piece_len = std::max<size_t>(1, static_cast<size_t>(raw_len + 0.5));
+  std::string piece;
+  while (bytes.size() < kSize) {
+    piece.clear();
+    AppendRandom(piece, piece_len);
+    size_t chunk = std::min(kChunk, kSize - bytes.size());
+    for (size_t i = 0; i < chunk; i++) {
+      bytes.push_back(piece[i % piece_len]);
+    }
+  }
+  return bytes;
+}
+
+inline void RandomBytePool::Fill(std::string &value, size_t len) {
+  const std::string &pool = Local();
+  size_t pos = utils::ThreadLocalRng().NextBelow(kSize);
+  value.clear();
+  while (len > 0) {
+    size_t n = std::min(len, kSize - pos);
+    value.append(pool, pos, n);
+    len -= n;
+    pos = 0;
+  }
+}
+
+} // ycsbc
+
+#endif // YCSB_C_RANDOM_BYTE_POOL_H_
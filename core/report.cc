@@ -0,0 +1,334 @@
+//
+//  report.cc
+//  YCSB-cpp
+//
+//  Machine-readable result files written at the end of each phase.
+//
+
+#include "report.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "utils/utils.h"
+
+namespace ycsbc {
+
+const std::string ResultReporter::PREFIX_PROPERTY = "report.prefix";
+const std::string ResultReporter::FORMAT_PROPERTY = "report.format";
+const std::string ResultReporter::FORMAT_DEFAULT = "json,csv";
+const std::string ResultReporter::PERCENTILES_PROPERTY = "report.percentiles";
+const std::string ResultReporter::PERCENTILES_DEFAULT = "50,90,95,99,99.9,99.99";
+
+namespace {
+
+std::vector<std::string> SplitList(const std::string &list) {
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    item = utils::Trim(item);
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+std::string JsonString(const std::string &str) {
+  std::ostringstream out;
+  out << '"';
+  for (unsigned char c : str) {
+    switch (c) {
+     case '"': out << "\\\""; break;
+     case '\\': out << "\\\\"; break;
+     case '\n': out << "\\n"; break;
+     case '\r': out << "\\r"; break;
+     case '\t': out << "\\t"; break;
+     default:
+      if (c < 0x20) {
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+      } else {
+        out << c;
+      }
+    }
+  }
+  out << '"';
+  return out.str();
+}
+
+std::string PercentileLabel(double percentile) {
+  std::ostringstream out;
+  out << 'p' << percentile;
+  return out.str();
+}
+
+// latencies are reported in microseconds, like the status messages
+double Micros(double nanos) {
+  return nanos / 1000.0;
+}
+
+void WriteJsonProperties(std::ostream &out, const utils::Properties &props) {
+  out << "  \"properties\": {";
+  const char *sep = "\n";
+  for (const auto &prop : props) {
+    out << sep << "    " << JsonString(prop.first) << ": " << JsonString(prop.second);
+    sep = ",\n";
+  }
+  out << "\n  },\n";
+}
+
+// properties go into comment lines so the table stays loadable as is
+void WriteCsvProperties(std::ostream &out, const utils::Properties &props) {
+  for (const auto &prop : props) {
+    out << "# " << prop.first << '=' << prop.second << '\n';
+  }
+}
+
+} // namespace
+
+ResultReporter::ResultReporter(const utils::Properties &props)
+    : json_(false), csv_(false) {
+  prefix_ = props.GetProperty(PREFIX_PROPERTY, "");
+
+  for (const std::string &format : SplitList(props.GetProperty(FORMAT_PROPERTY, FORMAT_DEFAULT))) {
+    if (format == "json") {
+      json_ = true;
+    } else if (format == "csv") {
+      csv_ = true;
+    } else {
+      throw utils::Exception("unknown report format: " + format);
+    }
+  }
+
+  for (const std::string &p : SplitList(props.GetProperty(PERCENTILES_PROPERTY, PERCENTILES_DEFAULT))) {
+    double percentile;
+    try {
+      percentile = std::stod(p);
+    } catch (const std::logic_error &) {
+      throw utils::Exception("invalid percentile: " + p);
+    }
+    if (percentile <= 0 || percentile > 100) {
+      throw utils::Exception("percentile out of range: " + p);
+    }
+    percentiles_.push_back(percentile);
+  }
+}
+
+void ResultReporter::Write(const std::string &phase, double runtime, uint64_t operations,
+                           Measurements &measurements, const utils::Properties &props) {
+  if (!enabled()) {
+    return;
+  }
+  std::vector<OpResult> results = Collect(measurements);
+  if (json_) {
+    WriteJson(prefix_ + phase + ".json", phase, runtime, operations, results, props);
+  }
+  if (csv_) {
+    WriteCsv(prefix_ + phase + ".csv", phase, runtime, operations, results, props);
+  }
+}
+
+void ResultReporter::WriteSweep(const std::string &phase, const std::vector<SweepStep> &steps,
+                                size_t peak, size_t knee, const utils::Properties &props) {
+  if (!enabled()) {
+    return;
+  }
+  if (json_) {
+    std::string path = prefix_ + phase + "-sweep.json";
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      throw utils::Exception("failed to open report file: " + path);
+    }
+    out << "{\n";
+    out << "  \"phase\": " << JsonString(phase) << ",\n";
+    out << "  \"peak_threads\": " << steps[peak].threads << ",\n";
+    out << "  \"peak_throughput_ops_sec\": " << steps[peak].Throughput() << ",\n";
+    out << "  \"knee_threads\": " << steps[knee].threads << ",\n";
+    out << "  \"knee_throughput_ops_sec\": " << steps[knee].Throughput() << ",\n";
+
+    WriteJsonProperties(out, props);
+
+    out << "  \"steps\": [";
+    const char *sep = "\n";
+    for (const SweepStep &step : steps) {
+      out << sep << "    {\"threads\": " << step.threads << ", \"runtime_sec\": " << step.runtime
+          << ", \"operations\": " << step.operations << ", \"throughput_ops_sec\": " << step.Throughput();
+      for (const auto &p : step.tail) {
+        out << ", " << JsonString(PercentileLabel(p.first) + "_us") << ": " << Micros(p.second);
+      }
+      out << "}";
+      sep = ",\n";
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+  }
+  if (csv_) {
+    std::string path = prefix_ + phase + "-sweep.csv";
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      throw utils::Exception("failed to open report file: " + path);
+    }
+    WriteCsvProperties(out, props);
+    out << "phase,threads,runtime_sec,operations,throughput_ops_sec,peak,knee";
+    for (const auto &p : steps[0].tail) {
+      out << ',' << PercentileLabel(p.first) << "_us";
+    }
+    out << '\n';
+    for (size_t i = 0; i < steps.size(); i++) {
+      const SweepStep &step = steps[i];
+      out << phase << ',' << step.threads << ',' << step.runtime << ',' << step.operations << ','
+          << step.Throughput() << ',' << (i == peak) << ',' << (i == knee);
+      for (const auto &p : step.tail) {
+        out << ',' << Micros(p.second);
+      }
+      out << '\n';
+    }
+  }
+}
+
+void ResultReporter::WriteSloSearch(const std::string &phase, const std::vector<SloStep> &steps,
+                                    size_t best, double percentile, double target_us,
+                                    const utils::Properties &props) {
+  if (!enabled()) {
+    return;
+  }
+  const std::string latency_label = PercentileLabel(percentile) + "_us";
+  if (json_) {
+    std::string path = prefix_ + phase + "-slo.json";
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      throw utils::Exception("failed to open report file: " + path);
+    }
+    out << "{\n";
+    out << "  \"phase\": " << JsonString(phase) << ",\n";
+    out << "  \"percentile\": " << percentile << ",\n";
+    out << "  \"target_us\": " << target_us << ",\n";
+    if (best < steps.size()) {
+      out << "  \"max_throughput_ops_sec\": " << steps[best].Throughput() << ",\n";
+      out << "  \"max_throughput_" << latency_label << "\": " << Micros(steps[best].latency) << ",\n";
+    } else {
+      out << "  \"max_throughput_ops_sec\": null,\n";
+    }
+
+    WriteJsonProperties(out, props);
+
+    out << "  \"steps\": [";
+    const char *sep = "\n";
+    for (const SloStep &step : steps) {
+      out << sep << "    {\"rate_ops_sec\": " << step.rate << ", \"runtime_sec\": " << step.runtime
+          << ", \"operations\": " << step.operations << ", \"throughput_ops_sec\": " << step.Throughput()
+          << ", " << JsonString(latency_label) << ": " << Micros(step.latency)
+          << ", \"sustained\": " << (step.sustained ? "true" : "false") << "}";
+      sep = ",\n";
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+  }
+  if (csv_) {
+    std::string path = prefix_ + phase + "-slo.csv";
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      throw utils::Exception("failed to open report file: " + path);
+    }
+    WriteCsvProperties(out, props);
+    out << "phase,rate_ops_sec,runtime_sec,operations,throughput_ops_sec," << latency_label
+        << ",target_us,sustained,best\n";
+    for (size_t i = 0; i < steps.size(); i++) {
+      const SloStep &step = steps[i];
+      out << phase << ',' << step.rate << ',' << step.runtime << ',' << step.operations << ','
+          << step.Throughput() << ',' << Micros(step.latency) << ',' << target_us << ','
+          << step.sustained << ',' << (i == best) << '\n';
+    }
+  }
+}
+
+std::vector<ResultReporter::OpResult> ResultReporter::Collect(Measurements &measurements) {
+  std::vector<OpResult> results;
+  // the failed variant of each operation sits INSERT_FAILED entries after it
+  for (int i = INSERT; i < INSERT_FAILED; i++) {
+    Operation op = static_cast<Operation>(i);
+    Operation failed = static_cast<Operation>(i + INSERT_FAILED);
+    OpResult result{op, measurements.Summarize(failed, {}).count,
+                    measurements.Summarize(op, percentiles_)};
+    if (result.latency.count > 0 || result.errors > 0) {
+      results.push_back(std::move(result));
+    }
+  }
+  return results;
+}
+
+void ResultReporter::WriteJson(const std::string &path, const std::string &phase, double runtime,
+                               uint64_t operations, const std::vector<OpResult> &results,
+                               const utils::Properties &props) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    throw utils::Exception("failed to open report file: " + path);
+  }
+
+  out << "{\n";
+  out << "  \"phase\": " << JsonString(phase) << ",\n";
+  out << "  \"runtime_sec\": " << runtime << ",\n";
+  out << "  \"operations\": " << operations << ",\n";
+  out << "  \"throughput_ops_sec\": " << (runtime > 0 ? operations / runtime : 0) << ",\n";
+
+  WriteJsonProperties(out, props);
+
+  out << "  \"operations_by_type\": {";
+  const char *sep = "\n";
+  for (const OpResult &result : results) {
+    const LatencySummary &lat = result.latency;
+    out << sep << "    " << JsonString(kOperationString[result.op]) << ": {\n";
+    out << "      \"count\": " << lat.count << ",\n";
+    out << "      \"errors\": " << result.errors << ",\n";
+    out << "      \"latency_us\": {\n";
+    out << "        \"mean\": " << Micros(lat.mean) << ",\n";
+    out << "        \"min\": " << Micros(lat.min) << ",\n";
+    out << "        \"max\": " << Micros(lat.max);
+    for (const auto &p : lat.percentiles) {
+      out << ",\n        " << JsonString(PercentileLabel(p.first)) << ": " << Micros(p.second);
+    }
+    out << "\n      }\n    }";
+    sep = ",\n";
+  }
+  out << "\n  }\n";
+  out << "}\n";
+}
+
+void ResultReporter::WriteCsv(const std::string &path, const std::string &phase, double runtime,
+                              uint64_t operations, const std::vector<OpResult> &results,
+                              const utils::Properties &props) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    throw utils::Exception("failed to open report file: " + path);
+  }
+
+  WriteCsvProperties(out, props);
+
+  out << "phase,runtime_sec,operations,throughput_ops_sec,operation,count,errors,"
+         "mean_us,min_us,max_us";
+  for (double p : percentiles_) {
+    out << ',' << PercentileLabel(p) << "_us";
+  }
+  out << '\n';
+
+  for (const OpResult &result : results) {
+    const LatencySummary &lat = result.latency;
+    out << phase << ',' << runtime << ',' << operations << ','
+        << (runtime > 0 ? operations / runtime : 0) << ','
+        << kOperationString[result.op] << ',' << lat.count << ',' << result.errors << ','
+        << Micros(lat.mean) << ',' << Micros(lat.min) << ',' << Micros(lat.max);
+    // percentiles are left empty by measurements that do not track them
+    for (size_t i = 0; i < percentiles_.size(); i++) {
+      out << ',';
+      if (i < lat.percentiles.size()) {
+        out << Micros(lat.percentiles[i].second);
+      }
+    }
+    out << '\n';
+  }
+}
+
+} // ycsbc
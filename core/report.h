@@ -0,0 +1,108 @@
+//
+//  report.h
+//  YCSB-cpp
+//
+//  Machine-readable result files written at the end of each phase.
+//
+
+#ifndef YCSB_C_REPORT_H_
+#define YCSB_C_REPORT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "measurements.h"
+#include "utils/properties.h"
+
+namespace ycsbc {
+
+///
+/// Result of one step of a sweep over thread counts.
+///
+struct SweepStep {
+  int threads;
+  double runtime;
+  uint64_t operations;
+  /// (percentile, latency in ns) pairs, the worst over the operation types
+  std::vector<std::pair<double, uint64_t>> tail;
+
+  double Throughput() const { return runtime > 0 ? operations / runtime : 0; }
+};
+
+///
+/// Result of one step of a search for the highest rate meeting a latency target.
+///
+struct SloStep {
+  double rate; // limit.ops of the step, 0 if unlimited
+  double runtime;
+  uint64_t operations;
+  uint64_t latency; // in ns, at the target percentile
+  bool sustained;
+
+  double Throughput() const { return runtime > 0 ? operations / runtime : 0; }
+};
+
+///
+/// Writes the result of a finished phase as JSON and/or CSV files.
+/// A phase named "run" with report.prefix=out/wa- ends up in out/wa-run.json
+/// and out/wa-run.csv. Nothing is written unless report.prefix is set.
+/// Scripted phases are named after their position, e.g. 2-run-workloada, and
+/// the steps of a sweep after their thread count, e.g. run-t8.
+///
+class ResultReporter {
+ public:
+  static const std::string PREFIX_PROPERTY;
+  static const std::string FORMAT_PROPERTY;
+  static const std::string FORMAT_DEFAULT;
+  static const std::string PERCENTILES_PROPERTY;
+  static const std::string PERCENTILES_DEFAULT;
+
+  explicit ResultReporter(const utils::Properties &props);
+
+  bool enabled() const { return !prefix_.empty(); }
+
+  ///
+  /// Writes the result of a phase, along with the properties it ran with.
+  ///
+  void Write(const std::string &phase, double runtime, uint64_t operations,
+             Measurements &measurements, const utils::Properties &props);
+
+  ///
+  /// Writes the steps of a sweep over thread counts to <phase>-sweep files,
+  /// marking the steps with the peak throughput and at the knee.
+  ///
+  void WriteSweep(const std::string &phase, const std::vector<SweepStep> &steps,
+                  size_t peak, size_t knee, const utils::Properties &props);
+
+  ///
+  /// Writes the steps of a latency target search to <phase>-slo files. best
+  /// is the sustained step with the highest throughput, steps.size() if none.
+  ///
+  void WriteSloSearch(const std::string &phase, const std::vector<SloStep> &steps, size_t best,
+                      double percentile, double target_us, const utils::Properties &props);
+
+ private:
+  struct OpResult {
+    Operation op;
+    uint64_t errors;
+    LatencySummary latency;
+  };
+
+  std::vector<OpResult> Collect(Measurements &measurements);
+  void WriteJson(const std::string &path, const std::string &phase, double runtime,
+                 uint64_t operations, const std::vector<OpResult> &results,
+                 const utils::Properties &props);
+  void WriteCsv(const std::string &path, const std::string &phase, double runtime,
+                uint64_t operations, const std::vector<OpResult> &results,
+                const utils::Properties &props);
+
+  std::string prefix_;
+  bool json_;
+  bool csv_;
+  std::vector<double> percentiles_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_REPORT_H_
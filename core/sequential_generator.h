@@ -0,0 +1,40 @@
+//
+//  sequential_generator.h
+//  YCSB-cpp
+//
+//  Integers in increasing order, wrapping around, shared by all threads.
+//
+
+#ifndef YCSB_C_SEQUENTIAL_GENERATOR_H_
+#define YCSB_C_SEQUENTIAL_GENERATOR_H_
+
+#include "generator.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace ycsbc {
+
+///
+/// Walks [min, max] in order and starts over at min, like the
+/// SequentialGenerator of YCSB. The position is shared, so the threads
+/// together visit each value once per round.
+///
+class SequentialGenerator : public Generator<uint64_t> {
+ public:
+  // Both min and max are inclusive
+  SequentialGenerator(uint64_t min, uint64_t max) : min_(min), interval_(max - min + 1), counter_(0) {}
+
+  uint64_t Next() { return last_.Get(min_) = min_ + counter_.fetch_add(1, std::memory_order_relaxed) % interval_; }
+  uint64_t Last() { return last_.Get(min_); }
+
+ private:
+  const uint64_t min_;
+  const uint64_t interval_;
+  std::atomic<uint64_t> counter_;
+  ThreadLocalState<uint64_t> last_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_SEQUENTIAL_GENERATOR_H_
@@ -0,0 +1,125 @@
+//
+//  shifting_generator.h
+//  YCSB-cpp
+//
+//  A key distribution whose popular keys move over time.
+//
+
+#ifndef YCSB_C_SHIFTING_GENERATOR_H_
+#define YCSB_C_SHIFTING_GENERATOR_H_
+
+#include "generator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include "counter_generator.h"
+#include "utils/utils.h"
+
+namespace ycsbc {
+
+///
+/// Shifts the values of a base generator over the keys acknowledged by a
+/// counter by an offset that grows with the operations issued or the time
+/// elapsed, wrapping around the last acknowledged key. Every period the
+/// offset grows by fraction of the keys, at once (jump) or spread over the
+/// period (drift). Progress is read once every kRefreshOps draws per thread,
+/// so the shared state is rarely touched.
+///
+class ShiftingGenerator : public Generator<uint64_t> {
+ public:
+  enum class Schedule { kOps, kTime };
+
+  static constexpr uint64_t kRefreshOps = 64;
+
+  ///
+  /// Takes ownership of base, whose values from 0 are drawn again until one
+  /// is acknowledged by counter. period is in operations with Schedule::kOps
+  /// and in milliseconds, from the first draw, with Schedule::kTime.
+  ///
+  ShiftingGenerator(Generator<uint64_t> *base, CounterGenerator &counter, Schedule schedule,
+                    uint64_t period, double fraction, bool drift);
+  ~ShiftingGenerator() { delete base_; }
+
+  uint64_t Next();
+  uint64_t Last() { return state_.Get(State{}).last; }
+
+ private:
+  struct State {
+    double offset = 0; // in rotations of the key space, [0, 1)
+    uint64_t until_refresh = 0;
+    uint64_t last = 0;
+  };
+
+  double Offset();
+
+  Generator<uint64_t> *base_;
+  CounterGenerator &counter_;
+  const Schedule schedule_;
+  const double period_;
+  const double fraction_;
+  const bool drift_;
+
+  std::atomic<uint64_t> ops_{0};
+  std::atomic<int64_t> start_ns_{0};
+  ThreadLocalState<State> state_;
+};
+
+inline ShiftingGenerator::ShiftingGenerator(Generator<uint64_t> *base, CounterGenerator &counter,
+                                            Schedule schedule, uint64_t period, double fraction,
+                                            bool drift)
+    : base_(base), counter_(counter), schedule_(schedule), period_(static_cast<double>(period)),
+      fraction_(fraction), drift_(drift) {
+  if (period == 0) {
+    throw utils::Exception("shifting.period must be positive");
+  }
+  if (!(fraction >= 0 && fraction <= 1)) {
+    throw utils::Exception("shifting.fraction must be in [0, 1]");
+  }
+}
+
+inline double ShiftingGenerator::Offset() {
+  double elapsed;
+  if (schedule_ == Schedule::kOps) {
+    // the ops up to the next refresh are counted in advance
+    elapsed = static_cast<double>(ops_.fetch_add(kRefreshOps, std::memory_order_relaxed));
+  } else {
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    // the first draw starts the clock; a failed exchange loads the start set by another thread
+    int64_t start = start_ns_.load(std::memory_order_relaxed);
+    if (start == 0 && start_ns_.compare_exchange_strong(start, now)) {
+      start = now;
+    }
+    elapsed = std::max<int64_t>(0, now - start) / 1e6;
+  }
+  double periods = elapsed / period_;
+  if (!drift_) {
+    periods = std::floor(periods);
+  }
+  return std::fmod(periods * fraction_, 1.0);
+}
+
+inline uint64_t ShiftingGenerator::Next() {
+  State &state = state_.Get(State{});
+  if (state.until_refresh == 0) {
+    state.offset = Offset();
+    state.until_refresh = kRefreshOps;
+  }
+  state.until_refresh--;
+  // the offset is scaled by the keys inserted so far, so the hot set never
+  // wraps into keys that do not exist yet
+  uint64_t count = counter_.Last() + 1;
+  uint64_t value;
+  do {
+    value = base_->Next();
+  } while (value >= count);
+  uint64_t offset = static_cast<uint64_t>(state.offset * count);
+  return state.last = (value + offset) % count;
+}
+
+} // ycsbc
+
+#endif // YCSB_C_SHIFTING_GENERATOR_H_
@@ -11,7 +11,6 @@
 
 #include "generator.h"
 
-#include <atomic>
 #include <cstdint>
 #include "counter_generator.h"
 #include "zipfian_generator.h"
@@ -26,16 +25,16 @@ class SkewedLatestGenerator : public Generator<uint64_t> {
   }
   
   uint64_t Next();
-  uint64_t Last() { return last_; }
+  uint64_t Last() { return last_.Get(0); }
  private:
   CounterGenerator &basis_;
   ZipfianGenerator zipfian_;
-  std::atomic<uint64_t> last_;
+  ThreadLocalState<uint64_t> last_;
 };
 
 inline uint64_t SkewedLatestGenerator::Next() {
   uint64_t max = basis_.Last();
-  return last_ = max - zipfian_.Next(max);
+  return last_.Get(0) = max - zipfian_.Next(max);
 }
 
 } // ycsbc
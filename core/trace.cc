@@ -0,0 +1,278 @@
+//
+//  trace.cc
+//  YCSB-cpp
+//
+
+#include "trace.h"
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <queue>
+
+namespace ycsbc {
+
+const std::string TraceWriter::RECORD_PROPERTY = "trace.record";
+const std::string TraceWriter::FORMAT_PROPERTY = "trace.format";
+const std::string TraceWriter::FORMAT_DEFAULT = "binary";
+
+namespace {
+
+std::string_view NextToken(const char *&pos, const char *end) {
+  while (pos < end && (*pos == ' ' || *pos == '\t')) {
+    pos++;
+  }
+  const char *begin = pos;
+  while (pos < end && *pos != ' ' && *pos != '\t') {
+    pos++;
+  }
+  return std::string_view(begin, pos - begin);
+}
+
+template <typename T>
+T ParseNumber(std::string_view token) {
+  T value;
+  auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+  if (token.empty() || result.ec != std::errc() || result.ptr != token.data() + token.size()) {
+    throw utils::Exception("Malformed trace line: bad number " + std::string(token));
+  }
+  return value;
+}
+
+int HexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+bool ValidEscapes(std::string_view key) {
+  for (size_t i = 0; i < key.size(); i++) {
+    if (key[i] == '%') {
+      if (i + 2 >= key.size() || HexDigit(key[i + 1]) < 0 || HexDigit(key[i + 2]) < 0) {
+        return false;
+      }
+      i += 2;
+    }
+  }
+  return true;
+}
+
+Operation ParseOperation(std::string_view token) {
+  for (int op = INSERT; op < INSERT_FAILED; op++) {
+    if (token == kOperationString[op]) {
+      return static_cast<Operation>(op);
+    }
+  }
+  throw utils::Exception("Malformed trace line: unknown operation " + std::string(token));
+}
+
+} // anonymous
+
+bool ParseTraceRecord(const char *&pos, const char *end, bool text, TraceRecord &record) {
+  if (!text) {
+    if (pos == end) {
+      return false;
+    }
+    TraceRecordHeader header;
+    if (static_cast<size_t>(end - pos) < sizeof(header)) {
+      throw utils::Exception("Truncated trace record");
+    }
+    std::memcpy(&header, pos, sizeof(header));
+    if (header.op >= INSERT_FAILED || static_cast<size_t>(end - pos) < sizeof(header) + header.key_len) {
+      throw utils::Exception("Malformed trace record");
+    }
+    record.timestamp = header.timestamp;
+    record.op = static_cast<Operation>(header.op);
+    record.key = std::string_view(pos + sizeof(header), header.key_len);
+    record.size = header.size;
+    pos += sizeof(header) + header.key_len;
+    return true;
+  }
+
+  while (pos < end) {
+    const char *eol = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+    const char *line_end = eol ? eol : end;
+    const char *next = eol ? eol + 1 : end;
+    if (line_end > pos && line_end[-1] == '\r') {
+      line_end--;
+    }
+    const char *p = pos;
+    std::string_view timestamp = NextToken(p, line_end);
+    if (timestamp.empty()) {
+      pos = next;
+      continue;
+    }
+    record.timestamp = ParseNumber<uint64_t>(timestamp);
+    record.op = ParseOperation(NextToken(p, line_end));
+    record.key = NextToken(p, line_end);
+    record.size = ParseNumber<uint32_t>(NextToken(p, line_end));
+    if (record.key.empty() || !ValidEscapes(record.key) || !NextToken(p, line_end).empty()) {
+      throw utils::Exception("Malformed trace line: " + std::string(pos, line_end - pos));
+    }
+    pos = next;
+    return true;
+  }
+  return false;
+}
+
+void DecodeTraceKey(const TraceRecord &record, bool text, std::string &key) {
+  if (!text) {
+    key.assign(record.key);
+    return;
+  }
+  key.clear();
+  for (size_t i = 0; i < record.key.size(); i++) {
+    if (record.key[i] == '%') {
+      key.push_back(static_cast<char>(HexDigit(record.key[i + 1]) << 4 | HexDigit(record.key[i + 2])));
+      i += 2;
+    } else {
+      key.push_back(record.key[i]);
+    }
+  }
+}
+
+TraceWriter::TraceWriter(const std::string &path, const std::string &format)
+    : start_(std::chrono::steady_clock::now()) {
+  if (format == "binary") {
+    text_ = false;
+  } else if (format == "text") {
+    text_ = true;
+  } else {
+    throw utils::Exception("Unknown trace format: " + format);
+  }
+  file_ = std::fopen(path.c_str(), text_ ? "w" : "wb");
+  if (!file_) {
+    throw utils::Exception("Cannot open trace file " + path);
+  }
+  if (!text_) {
+    std::fwrite(kTraceMagic, 1, sizeof(kTraceMagic), file_);
+  }
+}
+
+TraceWriter::~TraceWriter() {
+  // buffers are flushed from destructors, so write errors are only reported here
+  bool failed = false;
+  try {
+    Merge();
+  } catch (const utils::Exception &e) {
+    std::cerr << e.what() << std::endl;
+    failed = true;
+  }
+  for (std::FILE *spill : spills_) {
+    failed |= std::ferror(spill) != 0;
+    std::fclose(spill);
+  }
+  if (failed || std::ferror(file_) || std::fclose(file_) != 0) {
+    std::cerr << "Failed to write the trace file" << std::endl;
+  }
+}
+
+std::FILE *TraceWriter::NewSpill() {
+  std::FILE *spill = std::tmpfile();
+  if (!spill) {
+    throw utils::Exception("Cannot create a temporary file for the trace");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  spills_.push_back(spill);
+  return spill;
+}
+
+void TraceWriter::Merge() {
+  // the records of a buffer are in time order, so a k-way merge over the
+  // buffers orders the whole trace, holding one chunk per buffer
+  struct Run {
+    std::FILE *spill;
+    std::string chunk;
+    const char *pos;
+    const char *record_begin;
+    TraceRecord record;
+  };
+  auto advance = [this](Run &run) {
+    for (;;) {
+      run.record_begin = run.pos;
+      if (ParseTraceRecord(run.pos, run.chunk.data() + run.chunk.size(), text_, run.record)) {
+        return true;
+      }
+      uint64_t size;
+      if (std::fread(&size, sizeof(size), 1, run.spill) != 1) {
+        return false;
+      }
+      run.chunk.resize(size);
+      if (std::fread(&run.chunk[0], 1, size, run.spill) != size) {
+        throw utils::Exception("Truncated trace spill file");
+      }
+      run.pos = run.chunk.data();
+    }
+  };
+
+  std::vector<Run> runs(spills_.size());
+  using Head = std::pair<uint64_t, size_t>;
+  std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+  for (size_t i = 0; i < runs.size(); i++) {
+    runs[i].spill = spills_[i];
+    runs[i].pos = runs[i].chunk.data();
+    std::rewind(spills_[i]);
+    if (advance(runs[i])) {
+      heads.emplace(runs[i].record.timestamp, i);
+    }
+  }
+  while (!heads.empty()) {
+    Run &run = runs[heads.top().second];
+    heads.pop();
+    std::fwrite(run.record_begin, 1, run.pos - run.record_begin, file_);
+    if (advance(run)) {
+      heads.emplace(run.record.timestamp, &run - runs.data());
+    }
+  }
+}
+
+void TraceWriter::Buffer::Append(Operation op, const std::string &key, uint32_t size) {
+  uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - writer_->start_).count();
+  if (writer_->text_) {
+    data_.append(std::to_string(timestamp)).push_back(' ');
+    data_.append(kOperationString[op]).push_back(' ');
+    static const char kHex[] = "0123456789ABCDEF";
+    for (char c : key) {
+      unsigned char byte = static_cast<unsigned char>(c);
+      if (byte <= ' ' || byte >= 0x7f || c == '%') {
+        data_.push_back('%');
+        data_.push_back(kHex[byte >> 4]);
+        data_.push_back(kHex[byte & 0xf]);
+      } else {
+        data_.push_back(c);
+      }
+    }
+    data_.push_back(' ');
+    data_.append(std::to_string(size)).push_back('\n');
+  } else {
+    TraceRecordHeader header = {timestamp, size,
+                                static_cast<uint16_t>(std::min<size_t>(key.size(), UINT16_MAX)),
+                                static_cast<uint8_t>(op), 0};
+    data_.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    data_.append(key, 0, header.key_len);
+  }
+  if (data_.size() >= kFlushSize) {
+    Flush();
+  }
+}
+
+void TraceWriter::Buffer::Flush() {
+  if (!data_.empty()) {
+    uint64_t size = data_.size();
+    std::fwrite(&size, sizeof(size), 1, spill_);
+    std::fwrite(data_.data(), 1, data_.size(), spill_);
+    data_.clear();
+  }
+}
+
+} // ycsbc
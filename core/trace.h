@@ -0,0 +1,114 @@
+//
+//  trace.h
+//  YCSB-cpp
+//
+//  Recording and parsing of operation traces.
+//
+
+#ifndef YCSB_C_TRACE_H_
+#define YCSB_C_TRACE_H_
+
+#include "workload.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ycsbc {
+
+///
+/// One operation of a trace.
+/// size is the number of value bytes written by an insert or update, and the
+/// number of records of a scan.
+///
+struct TraceRecord {
+  uint64_t timestamp; // microseconds since the start of the recording
+  Operation op;
+  std::string_view key;
+  uint32_t size;
+};
+
+///
+/// Trace files come in two formats:
+///  - binary: the magic kTraceMagic, then per record a TraceRecordHeader
+///    followed by key_len key bytes, integers in host byte order;
+///  - text: one "<timestamp> <OPERATION> <key> <size>" line per record, with
+///    the key bytes that are not printable, space and '%' written as "%XX"
+///    in hex, so binary keys survive the round trip.
+///
+constexpr char kTraceMagic[8] = {'Y', 'C', 'S', 'B', 'T', 'R', 'C', '1'};
+
+struct TraceRecordHeader {
+  uint64_t timestamp;
+  uint32_t size;
+  uint16_t key_len;
+  uint8_t op;
+  uint8_t reserved;
+};
+static_assert(sizeof(TraceRecordHeader) == 16, "TraceRecordHeader must be packed");
+
+///
+/// Parses the record at pos, moving pos past it.
+/// Blank text lines are skipped; throws utils::Exception on malformed input.
+///
+/// @return false if no record is left before end.
+///
+bool ParseTraceRecord(const char *&pos, const char *end, bool text, TraceRecord &record);
+
+///
+/// Replaces key with the key of a parsed record, undoing the escapes of the
+/// text format.
+///
+void DecodeTraceKey(const TraceRecord &record, bool text, std::string &key);
+
+///
+/// Writes the operations issued through a set of DBWrappers to a trace file.
+/// Each wrapper appends to a Buffer of its own, which spills in large chunks
+/// to a temporary file, so recording an operation costs a clock read and a
+/// copy. The writer merges the spilled records by timestamp when it is
+/// destroyed, after the buffers, so the trace is in time order.
+///
+class TraceWriter {
+ public:
+  static const std::string RECORD_PROPERTY;
+  static const std::string FORMAT_PROPERTY;
+  static const std::string FORMAT_DEFAULT;
+
+  TraceWriter(const std::string &path, const std::string &format);
+  ~TraceWriter();
+
+  class Buffer {
+   public:
+    explicit Buffer(TraceWriter *writer) : writer_(writer), spill_(writer->NewSpill()) {}
+    ~Buffer() { Flush(); }
+
+    void Append(Operation op, const std::string &key, uint32_t size);
+    void Flush();
+
+   private:
+    static const size_t kFlushSize = 64 << 10;
+
+    TraceWriter *writer_;
+    std::FILE *spill_;
+    std::string data_;
+  };
+
+ private:
+  std::FILE *NewSpill();
+  void Merge();
+
+  bool text_;
+  std::FILE *file_;
+  // the records of each buffer, as chunks prefixed with their size
+  std::vector<std::FILE *> spills_;
+  std::mutex mutex_;
+  const std::chrono::steady_clock::time_point start_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_TRACE_H_
@@ -0,0 +1,224 @@
+//
+//  trace_workload.cc
+//  YCSB-cpp
+//
+
+#include "trace_workload.h"
+#include "core_workload.h"
+#include "random_byte_pool.h"
+#include "utils/utils.h"
+#include "workload_factory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ycsbc {
+
+const std::string TraceWorkload::FILE_PROPERTY = "trace.file";
+
+const std::string TraceWorkload::PACING_PROPERTY = "trace.pacing";
+const std::string TraceWorkload::PACING_DEFAULT = "false";
+
+const std::string TraceWorkload::SPEEDUP_PROPERTY = "trace.speedup";
+const std::string TraceWorkload::SPEEDUP_DEFAULT = "1.0";
+
+TraceWorkload::~TraceWorkload() {
+#ifndef _WIN32
+  if (mapped_) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+#endif
+}
+
+void TraceWorkload::Map(const std::string &path) {
+#ifndef _WIN32
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw utils::Exception("Cannot open trace file " + path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      madvise(addr, st.st_size, MADV_SEQUENTIAL);
+      data_ = static_cast<const char *>(addr);
+      size_ = st.st_size;
+      mapped_ = true;
+    }
+  }
+  close(fd);
+  if (mapped_) {
+    return;
+  }
+#endif
+  std::ifstream input(path, std::ios::binary);
+  if (!input) {
+    throw utils::Exception("Cannot open trace file " + path);
+  }
+  std::ostringstream buffer;
+  buffer << input.rdbuf();
+  contents_ = buffer.str();
+  data_ = contents_.data();
+  size_ = contents_.size();
+}
+
+void TraceWorkload::Init(const utils::Properties &p) {
+  if (!p.ContainsKey(FILE_PROPERTY)) {
+    throw utils::Exception(FILE_PROPERTY + " is required by TraceWorkload");
+  }
+  Map(p[FILE_PROPERTY]);
+
+  text_ = !(size_ >= sizeof(kTraceMagic) && std::memcmp(data_, kTraceMagic, sizeof(kTraceMagic)) == 0);
+  begin_ = text_ ? data_ : data_ + sizeof(kTraceMagic);
+  end_ = data_ + size_;
+
+  // one pass up front validates the whole trace, so replay never stops halfway
+  TraceRecord record;
+  uint64_t last_timestamp = 0;
+  const char *pos = begin_;
+  for (const char *next = pos; ParseTraceRecord(next, end_, text_, record); pos = next) {
+    if (record.op == MULTIREAD || record.op == BATCHWRITE) {
+      throw utils::Exception(std::string("Operation not supported in traces: ") + kOperationString[record.op]);
+    }
+    // blank text lines before a record are skipped again on replay
+    if (num_records_ % kBlockRecords == 0) {
+      blocks_.push_back(pos - data_);
+    }
+    if (num_records_ == 0) {
+      first_timestamp_ = record.timestamp;
+    }
+    first_timestamp_ = std::min(first_timestamp_, record.timestamp);
+    last_timestamp = std::max(last_timestamp, record.timestamp);
+    num_records_++;
+  }
+  if (num_records_ == 0) {
+    throw utils::Exception("Trace file " + p[FILE_PROPERTY] + " has no records");
+  }
+  duration_ = last_timestamp - first_timestamp_;
+  uint64_t num_threads = std::max(1, std::stoi(p.GetProperty("threadcount", "1")));
+  num_partitions_ = std::min<uint64_t>(num_threads, blocks_.size());
+
+  pacing_ = utils::StrToBool(p.GetProperty(PACING_PROPERTY, PACING_DEFAULT));
+  speedup_ = std::stod(p.GetProperty(SPEEDUP_PROPERTY, SPEEDUP_DEFAULT));
+  if (!(speedup_ > 0)) {
+    throw utils::Exception(SPEEDUP_PROPERTY + " must be positive");
+  }
+
+  table_name_ = p.GetProperty(CoreWorkload::TABLENAME_PROPERTY, CoreWorkload::TABLENAME_DEFAULT);
+  field_name_ = p.GetProperty(CoreWorkload::FIELD_NAME_PREFIX, CoreWorkload::FIELD_NAME_PREFIX_DEFAULT) + "0";
+  value_size_ = std::stoul(p.GetProperty(CoreWorkload::FIELD_LENGTH_PROPERTY, CoreWorkload::FIELD_LENGTH_DEFAULT));
+  RandomBytePool::SetCompressibility(std::stod(p.GetProperty(CoreWorkload::VALUE_COMPRESSIBILITY_PROPERTY,
+                                                             CoreWorkload::VALUE_COMPRESSIBILITY_DEFAULT)));
+}
+
+TraceWorkload::Cursor &TraceWorkload::Local() {
+  Cursor &cursor = cursors_.Get(Cursor{});
+  if (!cursor.claimed) {
+    // threads claim the partitions in the order they start
+    cursor.claimed = true;
+    cursor.partition = next_partition_.fetch_add(1) % num_partitions_;
+    cursor.block = cursor.partition;
+    cursor.left = 0;
+    cursor.lap = 0;
+  }
+  return cursor;
+}
+
+const TraceRecord &TraceWorkload::Next(Cursor &cursor) {
+  if (cursor.left == 0) {
+    if (cursor.pos) {
+      cursor.block += num_partitions_;
+    }
+    if (cursor.block >= blocks_.size()) {
+      cursor.block = cursor.partition;
+      cursor.lap++;
+    }
+    cursor.pos = data_ + blocks_[cursor.block];
+    cursor.left = std::min(kBlockRecords, num_records_ - cursor.block * kBlockRecords);
+  }
+  cursor.left--;
+  ParseTraceRecord(cursor.pos, end_, text_, cursor.record);
+  // the DB interface takes keys as strings
+  DecodeTraceKey(cursor.record, text_, cursor.key);
+  return cursor.record;
+}
+
+void TraceWorkload::Pace(Cursor &cursor) {
+  int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  // the first record issued starts the clock; a failed exchange loads the start set by another thread
+  int64_t start = start_ns_.load(std::memory_order_relaxed);
+  if (start == 0 && start_ns_.compare_exchange_strong(start, now)) {
+    start = now;
+  }
+  uint64_t offset = cursor.lap * duration_ + cursor.record.timestamp - first_timestamp_;
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::nanoseconds(start + static_cast<int64_t>(offset * 1000 / speedup_)))));
+}
+
+std::vector<DB::Field> &TraceWorkload::BuildValues(size_t size) {
+  static thread_local std::vector<DB::Field> values(1);
+  values[0].name.assign(field_name_);
+  RandomBytePool::Fill(values[0].value, size);
+  return values;
+}
+
+bool TraceWorkload::DoInsert(DB &db) {
+  Cursor &cursor = Local();
+  const TraceRecord &record = Next(cursor);
+  bool write = record.op == INSERT || record.op == UPDATE;
+  std::vector<DB::Field> &values = BuildValues(write ? record.size : value_size_);
+  return db.Insert(table_name_, cursor.key, values) == DB::kOK;
+}
+
+bool TraceWorkload::DoTransaction(DB &db) {
+  Cursor &cursor = Local();
+  const TraceRecord &record = Next(cursor);
+  if (pacing_) {
+    Pace(cursor);
+  }
+  switch (record.op) {
+    case READ: {
+      std::vector<DB::Field> result;
+      return db.Read(table_name_, cursor.key, nullptr, result) == DB::kOK;
+    }
+    case UPDATE:
+      return db.Update(table_name_, cursor.key, BuildValues(record.size)) == DB::kOK;
+    case INSERT:
+      return db.Insert(table_name_, cursor.key, BuildValues(record.size)) == DB::kOK;
+    case SCAN: {
+      std::vector<std::vector<DB::Field>> result;
+      return db.Scan(table_name_, cursor.key, record.size, nullptr, result) == DB::kOK;
+    }
+    case READMODIFYWRITE: {
+      std::vector<DB::Field> result;
+      if (db.Read(table_name_, cursor.key, nullptr, result) != DB::kOK) {
+        return false;
+      }
+      return db.Update(table_name_, cursor.key, BuildValues(record.size)) == DB::kOK;
+    }
+    case DELETE:
+      return db.Delete(table_name_, cursor.key) == DB::kOK;
+    default:
+      throw utils::Exception(std::string("Operation not supported in traces: ") + kOperationString[record.op]);
+  }
+}
+
+} // ycsbc
+
+static ycsbc::Workload *NewTraceWorkload() {
+  return new ycsbc::TraceWorkload();
+}
+
+const static bool registered = ycsbc::WorkloadFactory::RegisterWorkload("TraceWorkload", NewTraceWorkload);
@@ -0,0 +1,120 @@
+//
+//  trace_workload.h
+//  YCSB-cpp
+//
+//  Replays an operation trace recorded with trace.record or converted from
+//  elsewhere, see trace.h for the formats.
+//
+
+#ifndef YCSB_C_TRACE_WORKLOAD_H_
+#define YCSB_C_TRACE_WORKLOAD_H_
+
+#include "db.h"
+#include "generator.h"
+#include "trace.h"
+#include "utils/properties.h"
+#include "workload.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ycsbc {
+
+///
+/// Workload issuing the operations of a trace file.
+/// The file is memory mapped and streamed; Init validates it and keeps the
+/// offset of every kBlockRecords-th record only. With n client threads,
+/// thread i issues the blocks i, i + n, i + 2n, ... of consecutive records,
+/// parsing only its own; each starts over from the beginning once it reaches
+/// the end. The format is detected from the magic. Multi-key operations are
+/// traced per key, so MULTIREAD and BATCHWRITE records are rejected.
+///
+/// Inserts and updates write a single field of the recorded size. The load
+/// phase inserts the key of every record, with the recorded size for writes
+/// and fieldlength bytes otherwise. Bindings with a fixed schema must be set
+/// up for one field, e.g. fieldcount=1 for SQLite.
+///
+class TraceWorkload : public Workload {
+ public:
+  ///
+  /// The path of the trace to replay.
+  ///
+  static const std::string FILE_PROPERTY;
+
+  ///
+  /// Whether to issue each record at its recorded time instead of as fast as
+  /// possible. Times are relative to the first record of the trace and to
+  /// the first record issued by any thread, and grow by the duration of the
+  /// trace each time a thread starts it over.
+  ///
+  static const std::string PACING_PROPERTY;
+  static const std::string PACING_DEFAULT;
+
+  ///
+  /// Factor the recorded inter-arrival times are divided by when pacing.
+  ///
+  static const std::string SPEEDUP_PROPERTY;
+  static const std::string SPEEDUP_DEFAULT;
+
+  static constexpr uint64_t kBlockRecords = 64;
+
+  ~TraceWorkload();
+
+  void Init(const utils::Properties &p) override;
+  bool DoInsert(DB &db) override;
+  bool DoTransaction(DB &db) override;
+
+ private:
+  // replay position of a client thread
+  struct Cursor {
+    bool claimed = false;
+    uint64_t partition;
+    uint64_t block;
+    uint64_t left; // records left in the block
+    uint64_t lap;  // times the trace was started over
+    const char *pos = nullptr;
+    TraceRecord record;
+    std::string key;
+  };
+
+  Cursor &Local();
+  const TraceRecord &Next(Cursor &cursor);
+  void Pace(Cursor &cursor);
+  std::vector<DB::Field> &BuildValues(size_t size);
+
+  void Map(const std::string &path);
+
+  // whole file, mapped or read
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+  std::string contents_;
+  bool mapped_ = false;
+
+  // records, after the magic of a binary trace
+  const char *begin_ = nullptr;
+  const char *end_ = nullptr;
+  bool text_ = false;
+
+  // offset from data_ of the first record of every block
+  std::vector<uint64_t> blocks_;
+  uint64_t num_records_ = 0;
+  uint64_t num_partitions_ = 1;
+  std::atomic<uint64_t> next_partition_{0};
+  ThreadLocalState<Cursor> cursors_;
+
+  uint64_t first_timestamp_ = 0;
+  uint64_t duration_ = 0;
+  std::atomic<int64_t> start_ns_{0};
+
+  bool pacing_ = false;
+  double speedup_ = 1.0;
+  std::string table_name_;
+  std::string field_name_;
+  size_t value_size_ = 0;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_TRACE_WORKLOAD_H_
@@ -2,10 +2,17 @@
 #define YCSB_C_TWO_TERM_EXP_GENERATOR_H_
 #include <vector>
 
+#include "discrete_generator.h"
 #include "generator.h"
 
 namespace ycsbc {
 
+///
+/// Keys of db_bench's mixgraph: a key range is picked with probability
+/// following the two-term exponential model of the prefix_* parameters, then
+/// a key of the range through the power model of the key_dist_* parameters.
+/// The tables are immutable after construction and the state is per thread.
+///
 class TwoTermExpGenerator : public Generator<uint64_t> {
     public:
         TwoTermExpGenerator(uint64_t min, uint64_t max, uint64_t keyrange_num,
@@ -15,20 +22,21 @@ class TwoTermExpGenerator : public Generator<uint64_t> {
 
         uint64_t Next() override;
         uint64_t Last() override {
-            return last;
+            return last.Get(keyranges.front().k_start);
         }
     private:
         struct KeyrangeEntry {
-            uint64_t p_start;
             uint64_t k_start;
             uint64_t k_num;
         };
         std::vector<KeyrangeEntry> keyranges;
+        // picks the index of a key range in constant time
+        DiscreteGenerator<size_t> keyrange_chooser;
         double a_rec, b_rec;
-        std::mt19937_64 gen;
-        uint64_t last;
+        bool power_keys;
+        ThreadLocalState<uint64_t> last;
 };
 
 }
 
-#endif
\ No newline at end of file
+#endif
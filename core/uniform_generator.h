@@ -10,32 +10,31 @@
 #define YCSB_C_UNIFORM_GENERATOR_H_
 
 #include "generator.h"
-
-#include <atomic>
-#include <random>
+#include "utils/utils.h"
 
 namespace ycsbc {
 
 class UniformGenerator : public Generator<uint64_t> {
  public:
   // Both min and max are inclusive
-  UniformGenerator(uint64_t min, uint64_t max) : dist_(min, max) { Next(); }
+  UniformGenerator(uint64_t min, uint64_t max) : min_(min), range_(max - min + 1) {}
 
   uint64_t Next();
   uint64_t Last();
 
  private:
-  std::mt19937_64 generator_;
-  std::uniform_int_distribution<uint64_t> dist_;
-  uint64_t last_int_;
+  uint64_t min_;
+  uint64_t range_; // 0 for the full 64-bit range
+  ThreadLocalState<uint64_t> last_int_;
 };
 
 inline uint64_t UniformGenerator::Next() {
-  return last_int_ = dist_(generator_);
+  utils::Xoshiro256 &rng = utils::ThreadLocalRng();
+  return last_int_.Get(min_) = min_ + (range_ ? rng.NextBelow(range_) : rng.Next());
 }
 
 inline uint64_t UniformGenerator::Last() {
-  return last_int_;
+  return last_int_.Get(min_);
 }
 
 } // ycsbc
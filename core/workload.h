@@ -1,5 +1,6 @@
 #ifndef YCSB_C_WORKLOAD_H_
 #define YCSB_C_WORKLOAD_H_
+#include <functional>
 #include <string>
 #include "db.h"
 
@@ -12,12 +13,16 @@ enum Operation {
     SCAN,
     READMODIFYWRITE,
     DELETE,
+    MULTIREAD,
+    BATCHWRITE,
     INSERT_FAILED,
     READ_FAILED,
     UPDATE_FAILED,
     SCAN_FAILED,
     READMODIFYWRITE_FAILED,
     DELETE_FAILED,
+    MULTIREAD_FAILED,
+    BATCHWRITE_FAILED,
     MAXOPTYPE
 };
 
@@ -34,6 +39,51 @@ class Workload {
       
         virtual bool DoInsert(DB &db) = 0;
         virtual bool DoTransaction(DB &db) = 0;
+
+        ///
+        /// Issues an insert or a transaction through the asynchronous DB calls.
+        /// done is called with the result once it completes, either before
+        /// returning or from a later db.Poll(). The default implementations
+        /// run the synchronous versions.
+        ///
+        virtual void DoInsertAsync(DB &db, std::function<void(bool)> done) {
+            done(DoInsert(db));
+        }
+        virtual void DoTransactionAsync(DB &db, std::function<void(bool)> done) {
+            done(DoTransaction(db));
+        }
+
+        ///
+        /// Loads the records first to first + count - 1 of the load phase at once
+        /// through DB::BulkLoad. Several threads load disjoint ranges in parallel.
+        /// The default implementation runs DoInsert count times.
+        ///
+        /// @return The number of records loaded.
+        ///
+        virtual uint64_t DoBulkLoad(DB &db, uint64_t first, uint64_t count) {
+            uint64_t loaded = 0;
+            for (uint64_t i = 0; i < count; i++) {
+                loaded += DoInsert(db);
+            }
+            return loaded;
+        }
+
+        ///
+        /// Interval in milliseconds at which the run phase sets the request
+        /// rate to TargetRate(), 0 for workloads without a rate schedule.
+        ///
+        virtual int RateInterval() const {
+            return 0;
+        }
+
+        ///
+        /// Request rate of all client threads together in operations per
+        /// second, seconds after the run phase started. A rate <= 0 keeps the
+        /// previous one.
+        ///
+        virtual double TargetRate(double seconds) {
+            return 0;
+        }
 };
 
 }
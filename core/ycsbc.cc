@@ -10,18 +10,26 @@
 #include <cstring>
 #include <ctime>
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <iostream>
 #include <vector>
 #include <thread>
+#include <functional>
 #include <future>
 #include <chrono>
 #include <iomanip>
+#include <limits>
+#include <memory>
 
 #include "client.h"
 #include "core_workload.h"
 #include "db_factory.h"
 #include "measurements.h"
+#include "report.h"
+#include "trace.h"
 #include "workload_factory.h"
 #include "utils/countdown_latch.h"
 #include "utils/rate_limit.h"
@@ -30,9 +38,11 @@
 
 void UsageMessage(const char *command);
 bool StrStartWith(const char *str, const char *pre);
-void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props);
+void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props,
+                      ycsbc::utils::Properties &overrides);
 
-void StatusThread(ycsbc::Measurements *measurements, ycsbc::utils::CountDownLatch *latch, int interval) {
+void StatusThread(ycsbc::Measurements *measurements, ycsbc::Measurements *intended_measurements,
+                  ycsbc::utils::CountDownLatch *latch, int interval) {
   using namespace std::chrono;
   time_point<system_clock> start = system_clock::now();
   bool done = false;
@@ -46,6 +56,26 @@ void StatusThread(ycsbc::Measurements *measurements, ycsbc::utils::CountDownLatc
 
     std::cout << measurements->GetStatusMsg() << std::endl;
 
+    std::string interval_msg = measurements->GetIntervalMsg();
+    if (!interval_msg.empty()) {
+      std::cout << std::put_time(std::localtime(&now_c), "%F %T") << ' '
+                << static_cast<long long>(elapsed_time.count()) << " sec interval: "
+                << interval_msg << std::endl;
+    }
+
+    if (intended_measurements) {
+      std::cout << std::put_time(std::localtime(&now_c), "%F %T") << ' '
+                << static_cast<long long>(elapsed_time.count()) << " sec intended: "
+                << intended_measurements->GetStatusMsg() << std::endl;
+
+      interval_msg = intended_measurements->GetIntervalMsg();
+      if (!interval_msg.empty()) {
+        std::cout << std::put_time(std::localtime(&now_c), "%F %T") << ' '
+                  << static_cast<long long>(elapsed_time.count()) << " sec intended interval: "
+                  << interval_msg << std::endl;
+      }
+    }
+
     if (done) {
       break;
     }
@@ -86,152 +116,655 @@ void RateLimitThread(std::string rate_file, std::vector<ycsbc::utils::RateLimite
   }
 }
 
-int main(const int argc, const char *argv[]) {
+void RateScheduleThread(ycsbc::Workload *wl, std::vector<ycsbc::utils::RateLimiter *> rate_limiters,
+                        ycsbc::utils::CountDownLatch *latch) {
+  using namespace std::chrono;
+  steady_clock::time_point start = steady_clock::now();
+  int64_t num_threads = rate_limiters.size();
+
+  while (!latch->AwaitFor(milliseconds(wl->RateInterval()))) {
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+    double rate = wl->TargetRate(elapsed);
+    if (rate <= 0) {
+      continue;
+    }
+    for (auto x : rate_limiters) {
+      x->SetRate(std::max<int64_t>(1, rate / num_threads));
+    }
+  }
+}
+
+// A load or run phase and the properties it runs with
+struct Phase {
+  std::string label;
+  bool load;
   ycsbc::utils::Properties props;
-  ParseCommandLine(argc, argv, props);
+  // thread counts of the steps of a sweep, or the single thread count
+  std::vector<int> threads;
+  bool sweep;
+  bool slo;
+};
+
+// Parses a list of thread counts such as "1,2,4,8", which must be increasing.
+std::vector<int> ParseThreadCounts(const std::string &list) {
+  std::vector<int> counts;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    item = ycsbc::utils::Trim(item);
+    if (item.empty()) {
+      continue;
+    }
+    int count = std::stoi(item);
+    if (count < 1 || (!counts.empty() && count <= counts.back())) {
+      throw ycsbc::utils::Exception("thread counts must be increasing and positive: " + list);
+    }
+    counts.push_back(count);
+  }
+  if (counts.empty()) {
+    throw ycsbc::utils::Exception("no thread counts in: " + list);
+  }
+  return counts;
+}
 
-  const bool do_load = (props.GetProperty("doload", "false") == "true");
-  const bool do_transaction = (props.GetProperty("dotransaction", "false") == "true");
-  if (!do_load && !do_transaction) {
-    std::cerr << "No operation to do" << std::endl;
-    exit(1);
+// Returns the worst latency at each percentile over the operation types, or
+// nothing if the measurements do not track percentiles.
+std::vector<std::pair<double, uint64_t>> TailLatency(ycsbc::Measurements &measurements,
+                                                     const std::vector<double> &percentiles) {
+  std::vector<std::pair<double, uint64_t>> tail;
+  for (int i = ycsbc::INSERT; i < ycsbc::INSERT_FAILED; i++) {
+    ycsbc::LatencySummary summary = measurements.Summarize(static_cast<ycsbc::Operation>(i), percentiles);
+    if (summary.count == 0 || summary.percentiles.size() != percentiles.size()) {
+      continue;
+    }
+    if (tail.empty()) {
+      tail = summary.percentiles;
+      continue;
+    }
+    for (size_t j = 0; j < tail.size(); j++) {
+      tail[j].second = std::max(tail[j].second, summary.percentiles[j].second);
+    }
+  }
+  return tail;
+}
+
+// Returns the step past which adding threads stops paying off: the last one
+// before a step whose added threads each add less than knee times the
+// throughput per thread of the first step.
+size_t SweepKnee(const std::vector<ycsbc::SweepStep> &steps, double knee) {
+  const double base = steps[0].Throughput() / steps[0].threads;
+  size_t i = 1;
+  for (; i < steps.size(); i++) {
+    double gain = (steps[i].Throughput() - steps[i - 1].Throughput()) /
+                  (steps[i].threads - steps[i - 1].threads);
+    if (gain < knee * base) {
+      break;
+    }
   }
+  return i - 1;
+}
 
-  const int num_threads = stoi(props.GetProperty("threadcount", "1"));
+// Builds the phases of the phases property, e.g. "load,run:workloada,run:workloadb".
+// A phase "run:name" runs with the property file name if there is one, which
+// the command line -p settings still override, and then with the properties
+// prefixed by the file name without directories, e.g. workloada.operationcount.
+std::vector<Phase> ParsePhases(const ycsbc::utils::Properties &props,
+                               const ycsbc::utils::Properties &overrides) {
+  std::vector<Phase> phases;
+  std::stringstream list(props["phases"]);
+  std::string entry;
+  while (std::getline(list, entry, ',')) {
+    entry = ycsbc::utils::Trim(entry);
+    if (entry.empty()) {
+      continue;
+    }
+    size_t colon = entry.find(':');
+    std::string kind = entry.substr(0, colon);
+    std::string name = colon == std::string::npos ? "" : entry.substr(colon + 1);
+    if (kind != "load" && kind != "run") {
+      throw ycsbc::utils::Exception("unknown phase: " + entry);
+    }
 
-  ycsbc::Measurements *measurements = ycsbc::CreateMeasurements(&props);
-  if (measurements == nullptr) {
-    std::cerr << "Unknown measurements name" << std::endl;
+    Phase phase;
+    phase.load = kind == "load";
+    phase.label = std::to_string(phases.size() + 1) + "-" + kind;
+    phase.props = props;
+    if (!name.empty()) {
+      std::string base = name.substr(name.find_last_of('/') + 1);
+      phase.label += "-" + base;
+
+      std::ifstream input(name);
+      bool has_file = input.is_open();
+      if (has_file) {
+        phase.props.Load(input);
+        for (const auto &prop : overrides) {
+          phase.props.SetProperty(prop.first, prop.second);
+        }
+      }
+      bool has_overrides = false;
+      std::string prefix = base + ".";
+      for (const auto &prop : props) {
+        if (prop.first.size() > prefix.size() && prop.first.compare(0, prefix.size(), prefix) == 0) {
+          phase.props.SetProperty(prop.first.substr(prefix.size()), prop.second);
+          has_overrides = true;
+        }
+      }
+      if (!has_file && !has_overrides) {
+        throw ycsbc::utils::Exception("no property file or " + prefix + "* properties for phase " + entry);
+      }
+    }
+    phases.push_back(std::move(phase));
+  }
+  if (phases.empty()) {
+    throw ycsbc::utils::Exception("no phases in: " + props["phases"]);
+  }
+  return phases;
+}
+
+// Loads the records of the workload with the first num_threads dbs and returns
+// the number of records, setting runtime to the seconds it took.
+int LoadPhase(const ycsbc::utils::Properties &props, ycsbc::Workload &wl,
+              const std::vector<ycsbc::DBWrapper *> &dbs, int num_threads, bool init_db, bool cleanup_db,
+              uint64_t first_stream, ycsbc::Measurements *measurements,
+              ycsbc::Measurements *intended_measurements, double &runtime) {
+  const int total_ops = stoi(props[ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY]);
+
+  // operations each client thread keeps in flight through the asynchronous DB interface
+  const int queue_depth = std::stoi(props.GetProperty("client.queue_depth", "1"));
+  if (queue_depth < 1) {
+    std::cerr << "client.queue_depth must be at least 1" << std::endl;
     exit(1);
   }
 
-  std::vector<ycsbc::DB *> dbs;
-  for (int i = 0; i < num_threads; i++) {
-    ycsbc::DB *db = ycsbc::DBFactory::CreateDB(&props, measurements);
-    if (db == nullptr) {
-      std::cerr << "Unknown database name " << props["dbname"] << std::endl;
-      exit(1);
+  // load each thread's share of the records at once instead of one insert at a time
+  const bool bulk_load = ycsbc::utils::StrToBool(props.GetProperty("bulkload", "false"));
+
+  // print status periodically
+  const bool show_status = (props.GetProperty("status", "false") == "true");
+  const int status_interval = std::stoi(props.GetProperty("status.interval", "10"));
+
+  ycsbc::utils::CountDownLatch latch(num_threads);
+  ycsbc::utils::Timer<double> timer;
+
+  timer.Start();
+  std::future<void> status_future;
+  if (show_status) {
+    status_future = std::async(std::launch::async, StatusThread,
+                               measurements, intended_measurements, &latch, status_interval);
+  }
+  std::vector<std::future<int>> client_threads;
+  uint64_t first = 0;
+  for (int i = 0; i < num_threads; ++i) {
+    int thread_ops = total_ops / num_threads;
+    if (i < total_ops % num_threads) {
+      thread_ops++;
     }
-    dbs.push_back(db);
+
+    if (bulk_load) {
+      client_threads.emplace_back(std::async(std::launch::async, ycsbc::BulkLoadThread, dbs[i], &wl,
+                                             first, thread_ops, init_db, cleanup_db, &latch,
+                                             first_stream + i));
+    } else {
+      client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread, dbs[i], &wl,
+                                             thread_ops, true, init_db, cleanup_db, &latch, nullptr,
+                                             queue_depth, nullptr, first_stream + i));
+    }
+    first += thread_ops;
+  }
+  assert((int)client_threads.size() == num_threads);
+
+  int sum = 0;
+  for (auto &n : client_threads) {
+    assert(n.valid());
+    sum += n.get();
+  }
+  runtime = timer.End();
+
+  if (show_status) {
+    status_future.wait();
+  }
+  return sum;
+}
+
+// Runs the transactions of the workload with the first num_threads dbs and
+// returns the number of measured operations, setting runtime to the seconds
+// they took.
+int TransactionPhase(const ycsbc::utils::Properties &props, ycsbc::Workload &wl,
+                     const std::vector<ycsbc::DBWrapper *> &dbs, int num_threads, bool init_db,
+                     bool cleanup_db, uint64_t first_stream, ycsbc::Measurements *measurements,
+                     ycsbc::Measurements *intended_measurements, double &runtime) {
+  // initial ops per second, unlimited if <= 0
+  const int64_t ops_limit = std::stoi(props.GetProperty("limit.ops", "0"));
+  // rate file path for dynamic rate limiting, format "time_stamp_sec new_ops_per_second" per line
+  std::string rate_file = props.GetProperty("limit.file", "");
+  // workloads varying their own request rate, e.g. MixGraph with sine_mix_rate
+  const bool rate_schedule = wl.RateInterval() > 0;
+  if (rate_schedule && rate_file != "") {
+    std::cerr << "limit.file cannot be combined with a workload rate schedule" << std::endl;
+    exit(1);
   }
 
-  ycsbc::Workload *pwl = ycsbc::WorkloadFactory::CreateWorkload(&props);
-  ycsbc::Workload &wl = *pwl;
+  const int total_ops = stoi(props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY]);
+
+  // run time limit in seconds shared by all threads, unlimited if <= 0
+  const double max_execution_time = std::stod(props.GetProperty("maxexecutiontime", "0"));
+  // operations in the first warmup.time seconds or warmup.ops operations of each
+  // thread, and in the last cooldown.time seconds, are executed but not measured
+  const double warmup_time = std::stod(props.GetProperty("warmup.time", "0"));
+  const int warmup_ops = std::stoi(props.GetProperty("warmup.ops", "0"));
+  const double cooldown_time = std::stod(props.GetProperty("cooldown.time", "0"));
+  if (cooldown_time > 0 && max_execution_time <= 0) {
+    std::cerr << "cooldown.time requires maxexecutiontime" << std::endl;
+    exit(1);
+  }
+  if (max_execution_time > 0 && warmup_time + cooldown_time >= max_execution_time) {
+    std::cerr << "warmup.time and cooldown.time leave no time to measure" << std::endl;
+    exit(1);
+  }
+  const bool limited = max_execution_time > 0 || warmup_time > 0 || warmup_ops > 0;
+
+  // operations each client thread keeps in flight through the asynchronous DB interface
+  const int queue_depth = std::stoi(props.GetProperty("client.queue_depth", "1"));
+  if (queue_depth < 1) {
+    std::cerr << "client.queue_depth must be at least 1" << std::endl;
+    exit(1);
+  }
 
   // print status periodically
   const bool show_status = (props.GetProperty("status", "false") == "true");
   const int status_interval = std::stoi(props.GetProperty("status.interval", "10"));
 
-  // load phase
-  if (do_load) {
-    const int total_ops = stoi(props[ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY]);
-
-    ycsbc::utils::CountDownLatch latch(num_threads);
-    ycsbc::utils::Timer<double> timer;
+  ycsbc::utils::CountDownLatch latch(num_threads);
+  ycsbc::utils::Timer<double> timer;
 
-    timer.Start();
-    std::future<void> status_future;
-    if (show_status) {
-      status_future = std::async(std::launch::async, StatusThread,
-                                 measurements, &latch, status_interval);
+  timer.Start();
+  std::unique_ptr<ycsbc::RunLimits> limits;
+  if (limited) {
+    limits.reset(new ycsbc::RunLimits(ycsbc::RunLimits::Clock::now(), warmup_time,
+                                      warmup_ops / num_threads, cooldown_time, max_execution_time));
+  }
+  std::future<void> status_future;
+  if (show_status) {
+    status_future = std::async(std::launch::async, StatusThread,
+                               measurements, intended_measurements, &latch, status_interval);
+  }
+  std::vector<std::future<int>> client_threads;
+  std::vector<std::unique_ptr<ycsbc::utils::RateLimiter>> rate_limiter_owners;
+  std::vector<ycsbc::utils::RateLimiter *> rate_limiters;
+  for (int i = 0; i < num_threads; ++i) {
+    int thread_ops = total_ops / num_threads;
+    if (i < total_ops % num_threads) {
+      thread_ops++;
+    }
+    // a time-bounded run without operationcount runs until its deadline
+    if (total_ops == 0 && max_execution_time > 0) {
+      thread_ops = std::numeric_limits<int>::max();
     }
-    std::vector<std::future<int>> client_threads;
-    for (int i = 0; i < num_threads; ++i) {
-      int thread_ops = total_ops / num_threads;
-      if (i < total_ops % num_threads) {
-        thread_ops++;
+    ycsbc::utils::RateLimiter *rlim = nullptr;
+    if (ops_limit > 0 || rate_file != "" || rate_schedule) {
+      // a limit below one operation per thread would leave the threads unlimited
+      int64_t per_thread_ops = ops_limit > 0 ? std::max<int64_t>(1, ops_limit / num_threads) : 0;
+      if (rate_schedule && ops_limit <= 0) {
+        per_thread_ops = std::max<int64_t>(1, wl.TargetRate(0) / num_threads);
       }
-
-      client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread, dbs[i], &wl,
-                                             thread_ops, true, true, !do_transaction, &latch, nullptr));
+      // intended latencies need the open-loop schedule, which keeps the time lost in stalls
+      rlim = new ycsbc::utils::RateLimiter(per_thread_ops, per_thread_ops, intended_measurements != nullptr);
+      rate_limiter_owners.emplace_back(rlim);
     }
-    assert((int)client_threads.size() == num_threads);
+    rate_limiters.push_back(rlim);
+    client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread, dbs[i], &wl,
+                                           thread_ops, false, init_db, cleanup_db, &latch, rlim,
+                                           queue_depth, limits.get(), first_stream + i));
+  }
+
+  std::future<void> rlim_future;
+  if (rate_file != "") {
+    rlim_future = std::async(std::launch::async, RateLimitThread, rate_file, rate_limiters, &latch);
+  } else if (rate_schedule) {
+    rlim_future = std::async(std::launch::async, RateScheduleThread, &wl, rate_limiters, &latch);
+  }
 
-    int sum = 0;
-    for (auto &n : client_threads) {
-      assert(n.valid());
-      sum += n.get();
+  assert((int)client_threads.size() == num_threads);
+
+  int sum = 0;
+  for (auto &n : client_threads) {
+    assert(n.valid());
+    sum += n.get();
+  }
+  runtime = timer.End();
+  if (limits) {
+    // only the measured steady state counts
+    runtime = limits->MeasuredSeconds();
+  }
+
+  if (show_status) {
+    status_future.wait();
+  }
+  if (rlim_future.valid()) {
+    rlim_future.wait();
+  }
+  return sum;
+}
+
+int main(const int argc, const char *argv[]) {
+  ycsbc::utils::Properties props;
+  ycsbc::utils::Properties overrides;
+  ParseCommandLine(argc, argv, props, overrides);
+
+  // either the phases property or -load and -run
+  std::vector<Phase> phases;
+  const bool scripted = props.ContainsKey("phases");
+  if (scripted) {
+    try {
+      phases = ParsePhases(props, overrides);
+    } catch (const ycsbc::utils::Exception &e) {
+      std::cerr << e.what() << std::endl;
+      exit(1);
+    }
+  } else {
+    if (props.GetProperty("doload", "false") == "true") {
+      phases.push_back({"load", true, props, {}, false, false});
     }
-    double runtime = timer.End();
+    if (props.GetProperty("dotransaction", "false") == "true") {
+      phases.push_back({"run", false, props, {}, false, false});
+    }
+  }
+  if (phases.empty()) {
+    std::cerr << "No operation to do" << std::endl;
+    exit(1);
+  }
 
-    if (show_status) {
-      status_future.wait();
+  // phases may run with fewer threads, each thread keeps its DB instance across phases
+  int num_dbs = 0;
+  for (Phase &phase : phases) {
+    // a run phase with sweep.threads runs once per thread count, and one with
+    // slo.latency once per rate tried in the search for the highest one meeting it
+    phase.sweep = !phase.load && phase.props.ContainsKey("sweep.threads");
+    phase.slo = !phase.load && phase.props.ContainsKey("slo.latency");
+    if (phase.sweep && phase.slo) {
+      std::cerr << "sweep.threads cannot be combined with slo.latency" << std::endl;
+      exit(1);
     }
+    if (phase.slo && phase.props.GetProperty("limit.file", "") != "") {
+      std::cerr << "limit.file cannot be combined with slo.latency" << std::endl;
+      exit(1);
+    }
+    try {
+      phase.threads = ParseThreadCounts(phase.sweep ? phase.props["sweep.threads"]
+                                                    : phase.props.GetProperty("threadcount", "1"));
+    } catch (const ycsbc::utils::Exception &e) {
+      std::cerr << e.what() << std::endl;
+      exit(1);
+    }
+    num_dbs = std::max(num_dbs, phase.threads.back());
+  }
 
-    std::cout << "Load runtime(sec): " << runtime << std::endl;
-    std::cout << "Load operations(ops): " << sum << std::endl;
-    std::cout << "Load throughput(ops/sec): " << sum / runtime << std::endl;
+  // a fixed seed makes every client thread draw the same sequence on each run
+  if (props.ContainsKey("seed")) {
+    ycsbc::utils::SetRandomSeed(std::stoull(props["seed"]));
+  }
+
+  ycsbc::Measurements *measurements = ycsbc::CreateMeasurements(&props);
+  if (measurements == nullptr) {
+    std::cerr << "Unknown measurements name" << std::endl;
+    exit(1);
   }
 
-  measurements->Reset();
-  std::this_thread::sleep_for(std::chrono::seconds(stoi(props.GetProperty("sleepafterload", "0"))));
+  // latencies measured from the intended start of each operation, next to the service times
+  ycsbc::Measurements *intended_measurements = nullptr;
+  if (ycsbc::utils::StrToBool(props.GetProperty("measurement.intended", "false"))) {
+    intended_measurements = ycsbc::CreateMeasurements(&props, "intended-");
+  }
 
+  std::unique_ptr<ycsbc::ResultReporter> reporter;
+  try {
+    reporter = std::make_unique<ycsbc::ResultReporter>(props);
+  } catch (const ycsbc::utils::Exception &e) {
+    std::cerr << e.what() << std::endl;
+    exit(1);
+  }
+  // a report that cannot be written ends the benchmark like a bad property
+  auto write_report = [](const std::function<void()> &write) {
+    try {
+      write();
+    } catch (const ycsbc::utils::Exception &e) {
+      std::cerr << e.what() << std::endl;
+      exit(1);
+    }
+  };
 
-  // transaction phase
-  if (do_transaction) {
-    // initial ops per second, unlimited if <= 0
-    const int64_t ops_limit = std::stoi(props.GetProperty("limit.ops", "0"));
-    // rate file path for dynamic rate limiting, format "time_stamp_sec new_ops_per_second" per line
-    std::string rate_file = props.GetProperty("limit.file", "");
+  // records every operation issued to the databases, for replay by TraceWorkload
+  std::unique_ptr<ycsbc::TraceWriter> trace_writer;
+  if (props.ContainsKey(ycsbc::TraceWriter::RECORD_PROPERTY)) {
+    trace_writer = std::make_unique<ycsbc::TraceWriter>(
+        props[ycsbc::TraceWriter::RECORD_PROPERTY],
+        props.GetProperty(ycsbc::TraceWriter::FORMAT_PROPERTY, ycsbc::TraceWriter::FORMAT_DEFAULT));
+  }
 
-    const int total_ops = stoi(props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY]);
+  std::vector<ycsbc::DBWrapper *> dbs;
+  for (int i = 0; i < num_dbs; i++) {
+    ycsbc::DBWrapper *db = ycsbc::DBFactory::CreateDB(&props, measurements, intended_measurements);
+    if (db == nullptr) {
+      std::cerr << "Unknown database name " << props["dbname"] << std::endl;
+      exit(1);
+    }
+    if (trace_writer) {
+      db->SetTraceWriter(trace_writer.get());
+    }
+    dbs.push_back(db);
+  }
 
-    ycsbc::utils::CountDownLatch latch(num_threads);
-    ycsbc::utils::Timer<double> timer;
+  // the client threads of the first phase open their DB instances, and those
+  // of the last one close them, the instances they leave out are handled here
+  for (int i = phases.front().threads.front(); i < num_dbs; i++) {
+    dbs[i]->Init();
+  }
 
-    timer.Start();
-    std::future<void> status_future;
-    if (show_status) {
-      status_future = std::async(std::launch::async, StatusThread,
-                                 measurements, &latch, status_interval);
+  // the random streams of each step follow those of the previous one, a lone -run takes the second
+  uint64_t next_stream = scripted || phases.front().load ? 0 : num_dbs;
+  for (size_t p = 0; p < phases.size(); p++) {
+    const Phase &phase = phases[p];
+    if (scripted) {
+      std::cout << "Phase " << phase.label << std::endl;
     }
-    std::vector<std::future<int>> client_threads;
-    std::vector<ycsbc::utils::RateLimiter *> rate_limiters;
-    for (int i = 0; i < num_threads; ++i) {
-      int thread_ops = total_ops / num_threads;
-      if (i < total_ops % num_threads) {
-        thread_ops++;
+    const char *name = phase.load ? "Load" : "Run";
+    // a search cannot tell its last step in advance, so its DB instances are closed below
+    const bool last_phase = p + 1 == phases.size() && !phase.slo;
+    bool first_step = p == 0;
+
+    // runs a step of the phase and reports it, tail gets the worst latencies at
+    // percentiles over the operation types from tail_measurements
+    auto run_step = [&](ycsbc::utils::Properties &step_props, int threads, const std::string &label,
+                        bool last_step, ycsbc::Measurements *tail_measurements,
+                        const std::vector<double> &percentiles) {
+      const bool init_db = first_step;
+      const bool cleanup_db = last_phase && last_step;
+      first_step = false;
+      const uint64_t first_stream = next_stream;
+      next_stream += num_dbs;
+
+      ycsbc::Workload *wl = ycsbc::WorkloadFactory::CreateWorkload(&step_props);
+      if (wl == nullptr) {
+        std::cerr << "Unknown workload name " << step_props.GetProperty("workload") << std::endl;
+        exit(1);
       }
-      ycsbc::utils::RateLimiter *rlim = nullptr;
-      if (ops_limit > 0 || rate_file != "") {
-        int64_t per_thread_ops = ops_limit / num_threads;
-        rlim = new ycsbc::utils::RateLimiter(per_thread_ops, per_thread_ops);
+
+      double runtime;
+      int sum;
+      if (phase.load) {
+        sum = LoadPhase(step_props, *wl, dbs, threads, init_db, cleanup_db, first_stream,
+                        measurements, intended_measurements, runtime);
+      } else {
+        sum = TransactionPhase(step_props, *wl, dbs, threads, init_db, cleanup_db, first_stream,
+                               measurements, intended_measurements, runtime);
       }
-      rate_limiters.push_back(rlim);
-      client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread, dbs[i], &wl,
-                                             thread_ops, false, !do_load, true, &latch, rlim));
-    }
 
-    std::future<void> rlim_future;
-    if (rate_file != "") {
-      rlim_future = std::async(std::launch::async, RateLimitThread, rate_file, rate_limiters, &latch);
-    }
+      std::cout << name << " runtime(sec): " << runtime << std::endl;
+      std::cout << name << " operations(ops): " << sum << std::endl;
+      std::cout << name << " throughput(ops/sec): " << sum / runtime << std::endl;
+      write_report([&] {
+        reporter->Write(label, runtime, sum, *measurements, step_props);
+        if (intended_measurements) {
+          reporter->Write(label + "-intended", runtime, sum, *intended_measurements, step_props);
+        }
+      });
+      ycsbc::SweepStep step{threads, runtime, static_cast<uint64_t>(sum),
+                            TailLatency(*tail_measurements, percentiles)};
+
+      measurements->Reset();
+      if (intended_measurements) {
+        intended_measurements->Reset();
+      }
+      delete wl;
+      return step;
+    };
+
+    if (phase.sweep) {
+      std::vector<double> percentiles;
+      std::stringstream ss(phase.props.GetProperty("sweep.percentiles", "99,99.9"));
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        percentiles.push_back(std::stod(item));
+      }
 
-    assert((int)client_threads.size() == num_threads);
+      std::vector<ycsbc::SweepStep> steps;
+      for (size_t s = 0; s < phase.threads.size(); s++) {
+        const int threads = phase.threads[s];
+        std::cout << "Sweep step " << threads << " threads" << std::endl;
+        ycsbc::utils::Properties step_props = phase.props;
+        step_props.SetProperty("threadcount", std::to_string(threads));
+        steps.push_back(run_step(step_props, threads, phase.label + "-t" + std::to_string(threads),
+                                 s + 1 == phase.threads.size(), measurements, percentiles));
+      }
 
-    int sum = 0;
-    for (auto &n : client_threads) {
-      assert(n.valid());
-      sum += n.get();
-    }
-    double runtime = timer.End();
+      const double knee_fraction = std::stod(phase.props.GetProperty("sweep.knee", "0.5"));
+      size_t peak = 0;
+      for (size_t s = 1; s < steps.size(); s++) {
+        if (steps[s].Throughput() > steps[peak].Throughput()) {
+          peak = s;
+        }
+      }
+      size_t knee = SweepKnee(steps, knee_fraction);
+
+      std::cout << "Sweep threads, throughput(ops/sec)";
+      for (double percentile : percentiles) {
+        std::cout << ", p" << percentile << "(us)";
+      }
+      std::cout << std::endl;
+      for (const ycsbc::SweepStep &step : steps) {
+        std::cout << "Sweep " << step.threads << ", " << step.Throughput();
+        for (const auto &tail : step.tail) {
+          std::cout << ", " << tail.second / 1000.0;
+        }
+        std::cout << std::endl;
+      }
+      std::cout << "Sweep peak: " << steps[peak].threads << " threads, "
+                << steps[peak].Throughput() << " ops/sec" << std::endl;
+      std::cout << "Sweep knee: " << steps[knee].threads << " threads, "
+                << steps[knee].Throughput() << " ops/sec" << std::endl;
+      write_report([&] { reporter->WriteSweep(phase.label, steps, peak, knee, phase.props); });
+    } else if (phase.slo) {
+      const double target_us = std::stod(phase.props["slo.latency"]);
+      const double percentile = std::stod(phase.props.GetProperty("slo.percentile", "99"));
+      const double precision = std::stod(phase.props.GetProperty("slo.precision", "0.05"));
+      const size_t max_steps = std::stoul(phase.props.GetProperty("slo.steps", "12"));
+      double lo = std::stod(phase.props.GetProperty("slo.rate.min", "0"));
+      double hi = std::stod(phase.props.GetProperty("slo.rate.max", "0"));
+      // under a rate limit the intended latencies include the time spent queueing
+      ycsbc::Measurements *tail_measurements = intended_measurements ? intended_measurements : measurements;
+      const int threads = phase.threads.front();
+
+      std::vector<ycsbc::SloStep> steps;
+      size_t best = 0;
+      bool found = false;
+      // a rate is sustained if the DB keeps up with it within the latency target
+      auto probe = [&](double rate) {
+        std::cout << "SLO step " << steps.size() + 1 << ": ";
+        if (rate > 0) {
+          std::cout << rate << " ops/sec" << std::endl;
+        } else {
+          std::cout << "unlimited" << std::endl;
+        }
+        ycsbc::utils::Properties step_props = phase.props;
+        step_props.SetProperty("limit.ops", std::to_string(static_cast<int64_t>(rate)));
+        std::string label = phase.label + "-slo" + std::to_string(steps.size() + 1);
+        ycsbc::SweepStep result = run_step(step_props, threads, label, false, tail_measurements, {percentile});
+        if (result.tail.empty()) {
+          std::cerr << "slo.latency requires measurements tracking percentiles, "
+                       "e.g. measurementtype=hdrhistogram" << std::endl;
+          exit(1);
+        }
+        ycsbc::SloStep step{rate, result.runtime, result.operations, result.tail[0].second, false};
+        step.sustained = step.latency <= target_us * 1000 &&
+                         (rate <= 0 || step.Throughput() >= (1 - precision) * rate);
+        steps.push_back(step);
+        if (step.sustained && (!found || step.Throughput() > steps[best].Throughput())) {
+          best = steps.size() - 1;
+          found = true;
+        }
+        return step.sustained;
+      };
+
+      // without an upper bound, the unlimited throughput is one
+      if (hi <= 0) {
+        if (!probe(0)) {
+          hi = steps.back().Throughput();
+        }
+      }
+      // binary search for the highest sustained rate
+      while (hi > 0 && steps.size() < max_steps && hi - lo > precision * hi) {
+        double rate = (lo + hi) / 2;
+        if (probe(rate)) {
+          lo = rate;
+        } else {
+          hi = rate;
+        }
+      }
+      if (!found) {
+        best = steps.size();
+      }
 
-    if (show_status) {
-      status_future.wait();
+      std::cout << "SLO target: p" << percentile << " <= " << target_us << " us" << std::endl;
+      std::cout << "SLO rate(ops/sec), throughput(ops/sec), p" << percentile << "(us), sustained" << std::endl;
+      for (const ycsbc::SloStep &step : steps) {
+        std::cout << "SLO ";
+        if (step.rate > 0) {
+          std::cout << step.rate;
+        } else {
+          std::cout << "unlimited";
+        }
+        std::cout << ", " << step.Throughput() << ", " << step.latency / 1000.0 << ", "
+                  << (step.sustained ? "yes" : "no") << std::endl;
+      }
+      if (best < steps.size()) {
+        std::cout << "SLO max throughput(ops/sec): " << steps[best].Throughput() << std::endl;
+      } else {
+        std::cout << "SLO max throughput(ops/sec): none of the rates met the target" << std::endl;
+      }
+      write_report([&] {
+        reporter->WriteSloSearch(phase.label, steps, best, percentile, target_us, phase.props);
+      });
+    } else {
+      ycsbc::utils::Properties step_props = phase.props;
+      run_step(step_props, phase.threads.front(), phase.label, true, measurements, {});
     }
 
-    std::cout << "Run runtime(sec): " << runtime << std::endl;
-    std::cout << "Run operations(ops): " << sum << std::endl;
-    std::cout << "Run throughput(ops/sec): " << sum / runtime << std::endl;
+    if (phase.load && p + 1 < phases.size()) {
+      std::this_thread::sleep_for(std::chrono::seconds(stoi(phase.props.GetProperty("sleepafterload", "0"))));
+    }
   }
 
-  for (int i = 0; i < num_threads; i++) {
+  // the DB instances the client threads of the last phase did not close
+  for (int i = phases.back().slo ? 0 : phases.back().threads.back(); i < num_dbs; i++) {
+    dbs[i]->Cleanup();
+  }
+  for (int i = 0; i < num_dbs; i++) {
     delete dbs[i];
   }
-  delete pwl;
 }
 
-void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props) {
+void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props,
+                      ycsbc::utils::Properties &overrides) {
   int argindex = 1;
   while (argindex < argc && StrStartWith(argv[argindex], "-")) {
     if (strcmp(argv[argindex], "-load") == 0) {
@@ -248,6 +781,7 @@ void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &pr
         exit(0);
       }
       props.SetProperty("threadcount", argv[argindex]);
+      overrides.SetProperty("threadcount", argv[argindex]);
       argindex++;
     } else if (strcmp(argv[argindex], "-db") == 0) {
       argindex++;
@@ -257,6 +791,7 @@ void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &pr
         exit(0);
       }
       props.SetProperty("dbname", argv[argindex]);
+      overrides.SetProperty("dbname", argv[argindex]);
       argindex++;
     } else if (strcmp(argv[argindex], "-P") == 0) {
       argindex++;
@@ -291,9 +826,12 @@ void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &pr
       }
       props.SetProperty(ycsbc::utils::Trim(prop.substr(0, eq)),
                         ycsbc::utils::Trim(prop.substr(eq + 1)));
+      overrides.SetProperty(ycsbc::utils::Trim(prop.substr(0, eq)),
+                            ycsbc::utils::Trim(prop.substr(eq + 1)));
       argindex++;
     } else if (strcmp(argv[argindex], "-s") == 0) {
       props.SetProperty("status", "true");
+      overrides.SetProperty("status", "true");
       argindex++;
     } else {
       UsageMessage(argv[0]);
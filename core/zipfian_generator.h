@@ -12,13 +12,21 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
-#include <mutex>
+#include <vector>
 
 #include "generator.h"
 #include "utils/utils.h"
 
 namespace ycsbc {
 
+///
+/// Zipfian distribution over [min, min + n), after Gray et al., "Quickly
+/// Generating Billion-Record Synthetic Databases".
+/// The parameters computed at construction are immutable. Next(num) draws
+/// over a different number of items; the zeta and eta it needs are kept per
+/// thread and moved to num incrementally or in closed form, so threads never
+/// synchronize, and the count may grow or shrink.
+///
 class ZipfianGenerator : public Generator<uint64_t> {
  public:
   static constexpr double kZipfianConst = 0.99;
@@ -31,17 +39,10 @@ class ZipfianGenerator : public Generator<uint64_t> {
       ZipfianGenerator(min, max, zipfian_const, Zeta(max - min + 1, zipfian_const)) {}
 
   ZipfianGenerator(uint64_t min, uint64_t max, double zipfian_const, double zeta_n) :
-      items_(max - min + 1), base_(min), theta_(zipfian_const), allow_count_decrease_(false) {
+      items_(max - min + 1), base_(min), theta_(zipfian_const),
+      alpha_(1.0 / (1.0 - theta_)), zeta_2_(Zeta(2, theta_)), half_pow_theta_(1.0 + std::pow(0.5, theta_)),
+      zeta_n_(zeta_n), eta_(Eta(items_, zeta_n_)), zeta_prefix_(ZetaPrefix(theta_)) {
     assert(items_ >= 2 && items_ < kMaxNumItems);
-
-    zeta_2_ = Zeta(2, theta_);
-
-    alpha_ = 1.0 / (1.0 - theta_);
-    zeta_n_ = zeta_n;
-    count_for_zeta_ = items_;
-    eta_ = Eta();
-
-    Next();
   }
 
   uint64_t Next(uint64_t num_items);
@@ -50,70 +51,112 @@ class ZipfianGenerator : public Generator<uint64_t> {
 
   uint64_t Last();
 
- private:
-  double Eta() {
-    return (1 - std::pow(2.0 / items_, 1 - theta_)) / (1 - zeta_2_ / zeta_n_);
-  }
-
   ///
-  /// Calculate the zeta constant needed for a distribution.
-  /// Do this incrementally from the last_num of items to the cur_num.
-  /// Use the zipfian constant as theta. Remember the new number of items
-  /// so that, if it is changed, we can recompute zeta.
+  /// Returns zeta(num, theta), the sum of 1 / i^theta for i in [1, num].
+  /// Beyond kExactZetaItems terms, the tail is evaluated in closed form with
+  /// the Euler-Maclaurin formula, whose error is far below double precision.
   ///
-  static double Zeta(uint64_t last_num, uint64_t cur_num, double theta, double last_zeta) {
-    double zeta = last_zeta;
-    for (uint64_t i = last_num + 1; i <= cur_num; ++i) {
-      zeta += 1 / std::pow(i, theta);
-    }
-    return zeta;
+  static double Zeta(uint64_t num, double theta) {
+    return Zeta(num, theta, ZetaPrefix(theta));
   }
 
-  static double Zeta(uint64_t num, double theta) {
-    return Zeta(0, num, theta, 0);
+ private:
+  static constexpr uint64_t kExactZetaItems = 1024;
+  // largest count change applied term by term instead of in closed form
+  static constexpr uint64_t kMaxZetaSteps = 64;
+
+  struct State {
+    uint64_t count; /// Number of items used to compute zeta_n
+    double zeta_n;
+    double eta;
+    uint64_t last_value;
+  };
+
+  // zeta(i, theta) for i in [0, kExactZetaItems]
+  static std::vector<double> ZetaPrefix(double theta);
+  static double Zeta(uint64_t num, double theta, const std::vector<double> &prefix);
+
+  double Eta(uint64_t num, double zeta_n) const {
+    return (1 - std::pow(2.0 / num, 1 - theta_)) / (1 - zeta_2_ / zeta_n);
   }
 
-  uint64_t items_;
-  uint64_t base_; /// Min number of items to generate
+  void MoveTo(State &state, uint64_t num) const;
+
+  const uint64_t items_;
+  const uint64_t base_; /// Min number of items to generate
+
+  // Computed parameters for generating the distribution over items_
+  const double theta_, alpha_, zeta_2_, half_pow_theta_, zeta_n_, eta_;
+  // the exact terms of zeta, so moving far is not term by term
+  const std::vector<double> zeta_prefix_;
 
-  // Computed parameters for generating the distribution
-  double theta_, zeta_n_, eta_, alpha_, zeta_2_;
-  uint64_t count_for_zeta_; /// Number of items used to compute zeta_n
-  uint64_t last_value_;
-  std::mutex mutex_;
-  bool allow_count_decrease_;
+  ThreadLocalState<State> state_;
 };
 
+inline std::vector<double> ZipfianGenerator::ZetaPrefix(double theta) {
+  std::vector<double> prefix(kExactZetaItems + 1, 0.0);
+  for (uint64_t i = 1; i <= kExactZetaItems; ++i) {
+    prefix[i] = prefix[i - 1] + 1 / std::pow(i, theta);
+  }
+  return prefix;
+}
+
+inline double ZipfianGenerator::Zeta(uint64_t num, double theta, const std::vector<double> &prefix) {
+  uint64_t exact = num < kExactZetaItems ? num : kExactZetaItems;
+  double zeta = prefix[exact];
+  if (num == exact) {
+    return zeta;
+  }
+  // sum over (m, n] of f(i) = i^-theta ~ integral of f over [m, n]
+  //   + (f(n) - f(m)) / 2 + (f'(n) - f'(m)) / 12
+  const double m = static_cast<double>(exact);
+  const double n = static_cast<double>(num);
+  double integral = (theta == 1.0) ? std::log(n / m)
+                                   : (std::pow(n, 1 - theta) - std::pow(m, 1 - theta)) / (1 - theta);
+  double f_m = std::pow(m, -theta);
+  double f_n = std::pow(n, -theta);
+  return zeta + integral + (f_n - f_m) / 2 + theta * (f_m / m - f_n / n) / 12;
+}
+
+inline void ZipfianGenerator::MoveTo(State &state, uint64_t num) const {
+  if (num > state.count && num - state.count <= kMaxZetaSteps) {
+    for (uint64_t i = state.count + 1; i <= num; ++i) {
+      state.zeta_n += 1 / std::pow(i, theta_);
+    }
+  } else if (num < state.count && state.count - num <= kMaxZetaSteps) {
+    for (uint64_t i = num + 1; i <= state.count; ++i) {
+      state.zeta_n -= 1 / std::pow(i, theta_);
+    }
+  } else {
+    state.zeta_n = Zeta(num, theta_, zeta_prefix_);
+  }
+  state.count = num;
+  state.eta = Eta(num, state.zeta_n);
+}
+
 inline uint64_t ZipfianGenerator::Next(uint64_t num) {
   assert(num >= 2 && num < kMaxNumItems);
-  if (num != count_for_zeta_) {
-    // recompute zeta and eta
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (num > count_for_zeta_) {
-      zeta_n_ = Zeta(count_for_zeta_, num, theta_, zeta_n_);
-      count_for_zeta_ = num;
-      eta_ = Eta();
-    } else if (num < count_for_zeta_ && allow_count_decrease_) {
-      // TODO
-    }
+  State &state = state_.Get(State{items_, zeta_n_, eta_, base_});
+  if (num != state.count) {
+    MoveTo(state, num);
   }
 
-  double u = utils::ThreadLocalRandomDouble();
-  double uz = u * zeta_n_;
+  double u = utils::ThreadLocalRng().NextDouble();
+  double uz = u * state.zeta_n;
 
   if (uz < 1.0) {
-    return last_value_ = base_;
+    return state.last_value = base_;
   }
 
-  if (uz < 1.0 + std::pow(0.5, theta_)) {
-    return last_value_ = base_ + 1;
+  if (uz < half_pow_theta_) {
+    return state.last_value = base_ + 1;
   }
 
-  return last_value_ = base_ + num * std::pow(eta_ * u - eta_ + 1, alpha_);
+  return state.last_value = base_ + num * std::pow(state.eta * u - state.eta + 1, alpha_);
 }
 
 inline uint64_t ZipfianGenerator::Last() {
-  return last_value_;
+  return state_.Get(State{items_, zeta_n_, eta_, base_}).last_value;
 }
 
 }
@@ -1,5 +1,5 @@
+#include <cstring>
 #include <mutex>
-#include <future>
 
 #include "kvell_db.h"
 #include "core/db_factory.h"
@@ -11,8 +11,6 @@ extern "C" {
 
 }
 
-using payload_t = std::pair<std::promise<std::vector<ycsbc::DB::Field>>, const std::vector<std::string>*>;
-
 static size_t ref_cnt = 0;
 static std::mutex init_mutex;
 
@@ -76,54 +74,91 @@ static void DeserializeRow(std::vector<ycsbc::DB::Field> &values, const std::str
     DeserializeRow(values, p, lim);
 }
 
-static char* build_item(uint64_t key, const std::string &value) {
-    char *item = new char[sizeof(item_metadata) + sizeof(uint64_t) + value.size()];
-    auto item_meta = reinterpret_cast<item_metadata*>(item);
+struct ycsbc::KvellDB::Request {
+    slab_callback cb;
+    // key and value handed to the slab workers, reused across requests
+    std::vector<char> item;
+    KvellDB *db;
+    DB::Status status;
+    DB::Callback callback;
+    // run by Poll() on the client thread once the slab workers are done
+    void (KvellDB::*finish)(Request *);
+    void (*submit)(struct slab_callback *);
+    uint64_t key_num;
+    const std::vector<std::string> *fields;
+    std::vector<DB::Field> *result;
+    // current row read by an update, and the fields to change in it
+    std::vector<DB::Field> row;
+    std::vector<DB::Field> *values;
+    ScanState *scan;
+};
+
+struct ycsbc::KvellDB::ScanState {
+    size_t remaining;
+    DB::Callback callback;
+};
+
+static void build_item(std::vector<char> &item, uint64_t key, const std::string &value) {
+    item.resize(sizeof(item_metadata) + sizeof(uint64_t) + value.size());
+    auto item_meta = reinterpret_cast<item_metadata*>(item.data());
     item_meta->key_size = sizeof(uint64_t);
     item_meta->value_size = value.size();
-    *reinterpret_cast<uint64_t*>(item + sizeof(item_metadata)) = key;
-    memcpy(item + sizeof(item_metadata) + sizeof(uint64_t), value.data(), value.size());
-    return item;
-}
-
-static slab_callback* build_callback(uint64_t key, const std::string &value) {
-    slab_callback *cb = new slab_callback;
-    cb->payload = nullptr;
-    cb->item = build_item(key, value);
-    return cb;
-}
-
-static void free_callback(slab_callback *cb) {
-    delete[] static_cast<char*>(cb->item);
-    delete cb;
+    memcpy(item.data() + sizeof(item_metadata), &key, sizeof(uint64_t));
+    memcpy(item.data() + sizeof(item_metadata) + sizeof(uint64_t), value.data(), value.size());
 }
 
 static void read_cb(slab_callback *cb, void *item) {
-    auto payload = static_cast<payload_t*>(cb->param);
+    auto req = static_cast<ycsbc::KvellDB::Request*>(cb->param);
     auto item_meta = static_cast<item_metadata*>(item);
-    std::vector<ycsbc::DB::Field> result;
+    req->result->clear();
     if (item && item_meta->key_size != -1) {
         char *value = static_cast<char*>(item) + sizeof(item_metadata) + item_meta->key_size;
         char *value_end = value + item_meta->value_size;
-        if (payload->second)
-            DeserializeRowFilter(result, value, value_end, *payload->second);
+        if (req->fields)
+            DeserializeRowFilter(*req->result, value, value_end, *req->fields);
         else
-            DeserializeRow(result, value, value_end);
+            DeserializeRow(*req->result, value, value_end);
     }
-    payload->first.set_value(std::move(result));
-    free_callback(cb);
+    req->status = req->result->empty() ? ycsbc::DB::kNotFound : ycsbc::DB::kOK;
+    req->db->Complete(req);
 }
 
 static void put_cb(slab_callback *cb, void *item) {
     memory_index_add(cb, item);
-    free_callback(cb);
+    auto req = static_cast<ycsbc::KvellDB::Request*>(cb->param);
+    req->status = ycsbc::DB::kOK;
+    req->db->Complete(req);
 }
 
 static void delete_cb(slab_callback *cb, void *item) {
-    free_callback(cb);
+    auto req = static_cast<ycsbc::KvellDB::Request*>(cb->param);
+    req->status = ycsbc::DB::kOK;
+    req->db->Complete(req);
+}
+
+// issues an asynchronous operation and polls until it is done
+template <typename Issue>
+static ycsbc::DB::Status RunSync(ycsbc::KvellDB &db, Issue issue) {
+    ycsbc::DB::Status status = ycsbc::DB::kOK;
+    bool done = false;
+    issue([&status, &done](ycsbc::DB::Status s) {
+        status = s;
+        done = true;
+    });
+    while (!done)
+        db.Poll(true);
+    return status;
+}
+
+ycsbc::KvellDB::~KvellDB() {
+    for (Request *req : free_requests_)
+        delete req;
 }
 
 void ycsbc::KvellDB::Init() {
+    batch_size_ = std::stoull(props_->GetProperty("kvell.batch_size", "1"));
+    // only the padding of decimal keys is unknown here, and decoding ignores it
+    key_format_ = KeyFormat(*props_, 0);
     std::lock_guard<std::mutex> lock(init_mutex);
     if (ref_cnt++ == 0) {
         DB_PATH = strdup(props_->GetProperty("kvell.dbname", "/scratch%lu/kvell").c_str());
@@ -142,81 +177,89 @@ void ycsbc::KvellDB::Cleanup() {
     }
 }
 
-ycsbc::DB::Status ycsbc::KvellDB::Read(const std::string &table, const std::string &key,
-                                       const std::vector<std::string> *fields,
-                                       std::vector<DB::Field> &result) {
-    uint64_t key_num = std::stoull(key.substr(4));
-    slab_callback *cb = build_callback(key_num, "");
-    payload_t payload;
-    payload.second = fields;
-    cb->cb = read_cb;
-    cb->param = &payload;
-    kv_read_async(cb);
+ycsbc::KvellDB::Request *ycsbc::KvellDB::Acquire(uint64_t key_num, const std::string &value) {
+    Request *req;
+    if (free_requests_.empty()) {
+        req = new Request;
+    } else {
+        req = free_requests_.back();
+        free_requests_.pop_back();
+    }
+    memset(&req->cb, 0, sizeof(req->cb));
+    build_item(req->item, key_num, value);
+    req->cb.item = req->item.data();
+    req->cb.param = req;
+    req->db = this;
+    req->status = DB::kOK;
+    req->key_num = key_num;
+    req->fields = nullptr;
+    req->result = nullptr;
+    req->values = nullptr;
+    req->scan = nullptr;
+    return req;
+}
 
-    auto future = payload.first.get_future();
-    result = future.get();
-    if (result.empty())
-        return DB::kNotFound;
-    return DB::kOK;
+void ycsbc::KvellDB::Release(Request *req) {
+    req->callback = nullptr;
+    req->row.clear();
+    free_requests_.push_back(req);
 }
 
-ycsbc::DB::Status ycsbc::KvellDB::Scan(const std::string &table, const std::string &key,
-                                       int record_count, const std::vector<std::string> *fields,
-                                       std::vector<std::vector<DB::Field>> &result) {
-    uint64_t key_num = std::stoull(key.substr(4));
-    std::unique_ptr<char[]> item(build_item(key_num, ""));
-    auto scan_res = kv_init_scan(item.get(), record_count);
-    item.reset();
-
-    std::vector<payload_t> payloads(scan_res.nb_entries);
-    for(size_t i = 0; i < scan_res.nb_entries; i++) {
-        payloads[i].second = fields;
-        auto cb = build_callback(scan_res.hashes[i], "");
-        cb->cb = read_cb;
-        cb->param = &payloads[i];
-        kv_read_async_no_lookup(cb, scan_res.entries[i].slab, scan_res.entries[i].slab_idx);
+void ycsbc::KvellDB::Submit(Request *req, void (*submit)(struct slab_callback *)) {
+    req->submit = submit;
+    pending_.push_back(req);
+    if (pending_.size() >= batch_size_)
+        Flush();
+}
+
+void ycsbc::KvellDB::Flush() {
+    outstanding_ += pending_.size();
+    for (Request *req : pending_)
+        req->submit(&req->cb);
+    pending_.clear();
+}
+
+void ycsbc::KvellDB::Complete(Request *req) {
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready_.push_back(req);
     }
-    free(scan_res.hashes);
-    free(scan_res.entries);
+    ready_cv_.notify_one();
+}
 
-    result.clear();
-    result.reserve(scan_res.nb_entries);
-    for (auto &payload : payloads) {
-        auto future = payload.first.get_future();
-        result.push_back(future.get());
+int ycsbc::KvellDB::Poll(bool wait) {
+    Flush();
+    {
+        std::unique_lock<std::mutex> lock(ready_mutex_);
+        if (wait)
+            ready_cv_.wait(lock, [this] { return !ready_.empty() || outstanding_ == 0; });
+        completed_.swap(ready_);
     }
-    return DB::kOK;
+    int n = completed_.size();
+    outstanding_ -= completed_.size();
+    for (Request *req : completed_)
+        (this->*(req->finish))(req);
+    completed_.clear();
+    return n;
 }
 
-ycsbc::DB::Status ycsbc::KvellDB::Insert(const std::string &table, const std::string &key,
-                                         std::vector<DB::Field> &values) {
-    uint64_t key_num = std::stoull(key.substr(4));
-    std::string value;
-    SerializeRow(values, value);
-    auto cb = build_callback(key_num, value);
-    cb->cb = put_cb;
-    kv_add_or_update_async(cb);
-    return DB::kOK;
+void ycsbc::KvellDB::Finish(Request *req) {
+    DB::Callback callback = std::move(req->callback);
+    DB::Status status = req->status;
+    // released first, so the callback can issue the next request with it
+    Release(req);
+    callback(status);
 }
 
-ycsbc::DB::Status ycsbc::KvellDB::Update(const std::string &table, const std::string &key,
-                                         std::vector<DB::Field> &values) {
-    uint64_t key_num = std::stoull(key.substr(4));
-    payload_t payload;
-    payload.second = nullptr;
-    auto cb1 = build_callback(key_num, "");
-    cb1->cb = read_cb;
-    cb1->param = &payload;
-    kv_read_async(cb1);
-
-    auto future = payload.first.get_future();
-    auto current_values = future.get();
-    if (current_values.empty())
-        return DB::kNotFound;
-
-    for (Field &new_field : values) {
+void ycsbc::KvellDB::FinishUpdateRead(Request *req) {
+    if (req->status != DB::kOK) {
+        Finish(req);
+        return;
+    }
+
+    for (Field &new_field : *req->values) {
         bool found = false;
-        for (Field &cur_field : current_values) {
+        for (Field &cur_field : req->row) {
             if (cur_field.name == new_field.name) {
                 found = true;
                 cur_field.value = new_field.value;
@@ -227,23 +270,145 @@ ycsbc::DB::Status ycsbc::KvellDB::Update(const std::string &table, const std::st
     }
 
     std::string value;
-    SerializeRow(current_values, value);
-    auto cb2 = build_callback(key_num, value);
-    cb2->cb = put_cb;
-    kv_update_async(cb2);
-    return DB::kOK;
+    SerializeRow(req->row, value);
+    memset(&req->cb, 0, sizeof(req->cb));
+    build_item(req->item, req->key_num, value);
+    req->cb.item = req->item.data();
+    req->cb.param = req;
+    req->cb.cb = put_cb;
+    req->finish = &KvellDB::Finish;
+    Submit(req, kv_add_or_update_async);
+}
+
+void ycsbc::KvellDB::FinishScanEntry(Request *req) {
+    ScanState *scan = req->scan;
+    Release(req);
+    if (--scan->remaining == 0) {
+        DB::Callback callback = std::move(scan->callback);
+        delete scan;
+        callback(DB::kOK);
+    }
+}
+
+void ycsbc::KvellDB::ReadAsync(const std::string &table, const std::string &key,
+                               const std::vector<std::string> *fields,
+                               std::vector<DB::Field> &result, Callback callback) {
+    uint64_t key_num = key_format_.Decode(key);
+    Request *req = Acquire(key_num, "");
+    req->fields = fields;
+    req->result = &result;
+    req->callback = std::move(callback);
+    req->cb.cb = read_cb;
+    req->finish = &KvellDB::Finish;
+    Submit(req, kv_read_async);
+}
+
+void ycsbc::KvellDB::ScanAsync(const std::string &table, const std::string &key,
+                               int record_count, const std::vector<std::string> *fields,
+                               std::vector<std::vector<DB::Field>> &result, Callback callback) {
+    uint64_t key_num = key_format_.Decode(key);
+    std::vector<char> item;
+    build_item(item, key_num, "");
+    auto scan_res = kv_init_scan(item.data(), record_count);
+
+    result.clear();
+    result.resize(scan_res.nb_entries);
+    if (scan_res.nb_entries == 0) {
+        free(scan_res.hashes);
+        free(scan_res.entries);
+        callback(DB::kOK);
+        return;
+    }
+
+    // the entries are located already, so they go to the slab workers right away
+    ScanState *scan = new ScanState{scan_res.nb_entries, std::move(callback)};
+    outstanding_ += scan_res.nb_entries;
+    for (size_t i = 0; i < scan_res.nb_entries; i++) {
+        Request *req = Acquire(scan_res.hashes[i], "");
+        req->fields = fields;
+        req->result = &result[i];
+        req->scan = scan;
+        req->cb.cb = read_cb;
+        req->finish = &KvellDB::FinishScanEntry;
+        kv_read_async_no_lookup(&req->cb, scan_res.entries[i].slab, scan_res.entries[i].slab_idx);
+    }
+    free(scan_res.hashes);
+    free(scan_res.entries);
+}
+
+void ycsbc::KvellDB::InsertAsync(const std::string &table, const std::string &key,
+                                 std::vector<DB::Field> &values, Callback callback) {
+    uint64_t key_num = key_format_.Decode(key);
+    std::string value;
+    SerializeRow(values, value);
+    Request *req = Acquire(key_num, value);
+    req->callback = std::move(callback);
+    req->cb.cb = put_cb;
+    req->finish = &KvellDB::Finish;
+    Submit(req, kv_add_or_update_async);
+}
+
+void ycsbc::KvellDB::UpdateAsync(const std::string &table, const std::string &key,
+                                 std::vector<DB::Field> &values, Callback callback) {
+    // fields are updated in place, so the current row is read first
+    uint64_t key_num = key_format_.Decode(key);
+    Request *req = Acquire(key_num, "");
+    req->result = &req->row;
+    req->values = &values;
+    req->callback = std::move(callback);
+    req->cb.cb = read_cb;
+    req->finish = &KvellDB::FinishUpdateRead;
+    Submit(req, kv_read_async);
+}
+
+void ycsbc::KvellDB::DeleteAsync(const std::string &table, const std::string &key,
+                                 Callback callback) {
+    uint64_t key_num = key_format_.Decode(key);
+    Request *req = Acquire(key_num, "");
+    req->callback = std::move(callback);
+    req->cb.cb = delete_cb;
+    req->finish = &KvellDB::Finish;
+    Submit(req, kv_remove_async);
+}
+
+ycsbc::DB::Status ycsbc::KvellDB::Read(const std::string &table, const std::string &key,
+                                       const std::vector<std::string> *fields,
+                                       std::vector<DB::Field> &result) {
+    return RunSync(*this, [&](Callback callback) {
+        ReadAsync(table, key, fields, result, std::move(callback));
+    });
+}
+
+ycsbc::DB::Status ycsbc::KvellDB::Scan(const std::string &table, const std::string &key,
+                                       int record_count, const std::vector<std::string> *fields,
+                                       std::vector<std::vector<DB::Field>> &result) {
+    return RunSync(*this, [&](Callback callback) {
+        ScanAsync(table, key, record_count, fields, result, std::move(callback));
+    });
+}
+
+ycsbc::DB::Status ycsbc::KvellDB::Insert(const std::string &table, const std::string &key,
+                                         std::vector<DB::Field> &values) {
+    return RunSync(*this, [&](Callback callback) {
+        InsertAsync(table, key, values, std::move(callback));
+    });
+}
+
+ycsbc::DB::Status ycsbc::KvellDB::Update(const std::string &table, const std::string &key,
+                                         std::vector<DB::Field> &values) {
+    return RunSync(*this, [&](Callback callback) {
+        UpdateAsync(table, key, values, std::move(callback));
+    });
 }
 
 ycsbc::DB::Status ycsbc::KvellDB::Delete(const std::string &table, const std::string &key) {
-    uint64_t key_num = std::stoull(key.substr(4));
-    auto cb = build_callback(key_num, "");
-    cb->cb = delete_cb;
-    kv_remove_async(cb);
-    return DB::kOK;
+    return RunSync(*this, [&](Callback callback) {
+        DeleteAsync(table, key, std::move(callback));
+    });
 }
 
 static ycsbc::DB* NewKvellDB() {
     return new ycsbc::KvellDB;
 }
 
-const static bool registered = ycsbc::DBFactory::RegisterDB("kvell", NewKvellDB);
\ No newline at end of file
+const static bool registered = ycsbc::DBFactory::RegisterDB("kvell", NewKvellDB);
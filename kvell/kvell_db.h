@@ -1,12 +1,19 @@
 #ifndef YCSB_C_KVELL_DB_H_
 #define YCSB_C_KVELL_DB_H_
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 #include "core/db.h"
+#include "core/key_format.h"
+
+struct slab_callback;
 
 namespace ycsbc {
 
 class KvellDB : public DB {
     public:
-        virtual ~KvellDB() = default;
+        virtual ~KvellDB();
 
         virtual void Init() override;
         virtual void Cleanup() override;
@@ -21,9 +28,53 @@ class KvellDB : public DB {
         virtual Status Update(const std::string &table, const std::string &key,
                               std::vector<Field> &values) override;
         virtual Status Delete(const std::string &table, const std::string &key) override;
+
+        virtual void ReadAsync(const std::string &table, const std::string &key,
+                               const std::vector<std::string> *fields,
+                               std::vector<Field> &result, Callback callback) override;
+        virtual void ScanAsync(const std::string &table, const std::string &key,
+                               int record_count, const std::vector<std::string> *fields,
+                               std::vector<std::vector<Field>> &result, Callback callback) override;
+        virtual void InsertAsync(const std::string &table, const std::string &key,
+                                 std::vector<Field> &values, Callback callback) override;
+        virtual void UpdateAsync(const std::string &table, const std::string &key,
+                                 std::vector<Field> &values, Callback callback) override;
+        virtual void DeleteAsync(const std::string &table, const std::string &key,
+                                 Callback callback) override;
+        virtual int Poll(bool wait) override;
+
+        // state of one request to the slab workers, pooled per client thread
+        struct Request;
+        // called by the slab workers once a request is done
+        void Complete(Request *req);
+
     private:
+        struct ScanState;
+
+        Request *Acquire(uint64_t key_num, const std::string &value);
+        void Release(Request *req);
+        void Submit(Request *req, void (*submit)(struct slab_callback *));
+        void Flush();
+        void Finish(Request *req);
+        void FinishUpdateRead(Request *req);
+        void FinishScanEntry(Request *req);
+
+        size_t batch_size_;
+        // keys are stored as numbers, decoded from the workload's keys
+        KeyFormat key_format_;
+        // built requests not handed to the slab workers yet
+        std::vector<Request *> pending_;
+        // requests handed over and not returned by Poll() yet
+        size_t outstanding_ = 0;
+        std::vector<Request *> free_requests_;
+
+        // completion queue filled by the slab workers
+        std::mutex ready_mutex_;
+        std::condition_variable ready_cv_;
+        std::vector<Request *> ready_;
+        std::vector<Request *> completed_;
 };
 
 }
 
-#endif
\ No newline at end of file
+#endif
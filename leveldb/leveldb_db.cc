@@ -67,6 +67,8 @@ void LeveldbDB::Init() {
     method_update_ = &LeveldbDB::UpdateSingleEntry;
     method_insert_ = &LeveldbDB::InsertSingleEntry;
     method_delete_ = &LeveldbDB::DeleteSingleEntry;
+    method_multiread_ = &LeveldbDB::MultiReadSingleEntry;
+    method_batchwrite_ = &LeveldbDB::BatchWriteSingleEntry;
   } else if (format == "row") {
     format_ = kRowMajor;
     method_read_ = &LeveldbDB::ReadCompKeyRM;
@@ -74,6 +76,8 @@ void LeveldbDB::Init() {
     method_update_ = &LeveldbDB::InsertCompKey;
     method_insert_ = &LeveldbDB::InsertCompKey;
     method_delete_ = &LeveldbDB::DeleteCompKey;
+    method_multiread_ = &LeveldbDB::MultiReadEach;
+    method_batchwrite_ = &LeveldbDB::BatchWriteCompKey;
   } else if (format == "column") {
     format_ = kColumnMajor;
     method_read_ = &LeveldbDB::ReadCompKeyCM;
@@ -81,6 +85,8 @@ void LeveldbDB::Init() {
     method_update_ = &LeveldbDB::InsertCompKey;
     method_insert_ = &LeveldbDB::InsertCompKey;
     method_delete_ = &LeveldbDB::DeleteCompKey;
+    method_multiread_ = &LeveldbDB::MultiReadEach;
+    method_batchwrite_ = &LeveldbDB::BatchWriteCompKey;
   } else {
     throw utils::Exception("unknown format");
   }
@@ -340,6 +346,62 @@ DB::Status LeveldbDB::DeleteSingleEntry(const std::string &table, const std::str
   return kOK;
 }
 
+DB::Status LeveldbDB::BatchWriteSingleEntry(const std::string &table,
+                                            const std::vector<std::string> &keys,
+                                            std::vector<std::vector<Field>> &values) {
+  leveldb::WriteBatch batch;
+  std::string data;
+  for (size_t i = 0; i < keys.size(); i++) {
+    data.clear();
+    SerializeRow(values[i], &data);
+    batch.Put(keys[i], data);
+  }
+  leveldb::WriteOptions wopt;
+  leveldb::Status s = db_->Write(wopt, &batch);
+  if (!s.ok()) {
+    throw utils::Exception(std::string("LevelDB Write: ") + s.ToString());
+  }
+  return kOK;
+}
+
+DB::Status LeveldbDB::MultiReadSingleEntry(const std::string &table,
+                                           const std::vector<std::string> &keys,
+                                           const std::vector<std::string> *fields,
+                                           std::vector<std::vector<Field>> &result) {
+  // LevelDB has no batched Get, so the batch is read from one snapshot
+  leveldb::ReadOptions ropt;
+  ropt.snapshot = db_->GetSnapshot();
+  Status status = kOK;
+  std::string data;
+  result.resize(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    result[i].clear();
+    leveldb::Status s = db_->Get(ropt, keys[i], &data);
+    if (s.IsNotFound()) {
+      if (status == kOK) {
+        status = kNotFound;
+      }
+      continue;
+    } else if (!s.ok()) {
+      db_->ReleaseSnapshot(ropt.snapshot);
+      throw utils::Exception(std::string("LevelDB Get: ") + s.ToString());
+    }
+    if (fields != nullptr) {
+      DeserializeRowFilter(&result[i], data, *fields);
+    } else {
+      DeserializeRow(&result[i], data);
+    }
+  }
+  db_->ReleaseSnapshot(ropt.snapshot);
+  return status;
+}
+
+DB::Status LeveldbDB::MultiReadEach(const std::string &table, const std::vector<std::string> &keys,
+                                    const std::vector<std::string> *fields,
+                                    std::vector<std::vector<Field>> &result) {
+  return DB::MultiRead(table, keys, fields, result);
+}
+
 DB::Status LeveldbDB::ReadCompKeyRM(const std::string &table, const std::string &key,
                                     const std::vector<std::string> *fields,
                                     std::vector<Field> &result) {
@@ -456,6 +518,27 @@ DB::Status LeveldbDB::InsertCompKey(const std::string &table, const std::string
   return kOK;
 }
 
+DB::Status LeveldbDB::BatchWriteCompKey(const std::string &table,
+                                        const std::vector<std::string> &keys,
+                                        std::vector<std::vector<Field>> &values) {
+  leveldb::WriteOptions wopt;
+  leveldb::WriteBatch batch;
+
+  std::string comp_key;
+  for (size_t i = 0; i < keys.size(); i++) {
+    for (Field &field : values[i]) {
+      comp_key = BuildCompKey(keys[i], field.name);
+      batch.Put(comp_key, field.value);
+    }
+  }
+
+  leveldb::Status s = db_->Write(wopt, &batch);
+  if (!s.ok()) {
+    throw utils::Exception(std::string("LevelDB Write: ") + s.ToString());
+  }
+  return kOK;
+}
+
 DB::Status LeveldbDB::DeleteCompKey(const std::string &table, const std::string &key) {
   leveldb::WriteOptions wopt;
   leveldb::WriteBatch batch;
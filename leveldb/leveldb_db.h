@@ -54,6 +54,16 @@ class LeveldbDB : public DB {
     return (this->*(method_delete_))(table, key);
   }
 
+  Status MultiRead(const std::string &table, const std::vector<std::string> &keys,
+                   const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result) {
+    return (this->*(method_multiread_))(table, keys, fields, result);
+  }
+
+  Status BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                    std::vector<std::vector<Field>> &values) {
+    return (this->*(method_batchwrite_))(table, keys, values);
+  }
+
  private:
   enum LdbFormat {
     kSingleEntry,
@@ -81,6 +91,14 @@ class LeveldbDB : public DB {
   Status InsertSingleEntry(const std::string &table, const std::string &key,
                            std::vector<Field> &values);
   Status DeleteSingleEntry(const std::string &table, const std::string &key);
+  Status MultiReadSingleEntry(const std::string &table, const std::vector<std::string> &keys,
+                              const std::vector<std::string> *fields,
+                              std::vector<std::vector<Field>> &result);
+  Status BatchWriteSingleEntry(const std::string &table, const std::vector<std::string> &keys,
+                               std::vector<std::vector<Field>> &values);
+  Status MultiReadEach(const std::string &table, const std::vector<std::string> &keys,
+                       const std::vector<std::string> *fields,
+                       std::vector<std::vector<Field>> &result);
 
   Status ReadCompKeyRM(const std::string &table, const std::string &key,
                        const std::vector<std::string> *fields, std::vector<Field> &result);
@@ -95,6 +113,8 @@ class LeveldbDB : public DB {
   Status InsertCompKey(const std::string &table, const std::string &key,
                        std::vector<Field> &values);
   Status DeleteCompKey(const std::string &table, const std::string &key);
+  Status BatchWriteCompKey(const std::string &table, const std::vector<std::string> &keys,
+                           std::vector<std::vector<Field>> &values);
 
   Status (LeveldbDB::*method_read_)(const std::string &, const std:: string &,
                                     const std::vector<std::string> *, std::vector<Field> &);
@@ -106,6 +126,11 @@ class LeveldbDB : public DB {
   Status (LeveldbDB::*method_insert_)(const std::string &, const std::string &,
                                       std::vector<Field> &);
   Status (LeveldbDB::*method_delete_)(const std::string &, const std::string &);
+  Status (LeveldbDB::*method_multiread_)(const std::string &, const std::vector<std::string> &,
+                                         const std::vector<std::string> *,
+                                         std::vector<std::vector<Field>> &);
+  Status (LeveldbDB::*method_batchwrite_)(const std::string &, const std::vector<std::string> &,
+                                          std::vector<std::vector<Field>> &);
 
   int fieldcount_;
   std::string field_prefix_;
@@ -332,6 +332,39 @@ DB::Status LmdbDB::Insert(const std::string &table, const std::string &key, std:
   return kOK;
 }
 
+DB::Status LmdbDB::BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                              std::vector<std::vector<Field>> &values) {
+  MDB_txn *txn;
+  MDB_val key_slice, val_slice;
+  std::string data;
+
+  int ret;
+  ret = mdb_txn_begin(env_, nullptr, 0, &txn);
+  if (ret) {
+    throw utils::Exception(std::string("BatchWrite mdb_txn_begin: ") + mdb_strerror(ret));
+  }
+  for (size_t i = 0; i < keys.size(); i++) {
+    key_slice.mv_data = static_cast<void *>(const_cast<char *>(keys[i].data()));
+    key_slice.mv_size = keys[i].size();
+
+    data.clear();
+    SerializeRow(values[i], &data);
+    val_slice.mv_data = static_cast<void *>(const_cast<char *>(data.data()));
+    val_slice.mv_size = data.size();
+
+    ret = mdb_put(txn, dbi_, &key_slice, &val_slice, 0);
+    if (ret) {
+      mdb_txn_abort(txn);
+      throw utils::Exception(std::string("BatchWrite mdb_put: ") + mdb_strerror(ret));
+    }
+  }
+  ret = mdb_txn_commit(txn);
+  if (ret) {
+    throw utils::Exception(std::string("BatchWrite mdb_txn_commit: ") + mdb_strerror(ret));
+  }
+  return kOK;
+}
+
 DB::Status LmdbDB::Delete(const std::string &table, const std::string &key) {
   MDB_txn *txn;
   MDB_val key_slice;
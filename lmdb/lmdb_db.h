@@ -38,6 +38,9 @@ class LmdbDB : public DB {
 
   Status Delete(const std::string &table, const std::string &key);
 
+  Status BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                    std::vector<std::vector<Field>> &values);
+
  private:
   void SerializeRow(const std::vector<Field> &values, std::string *data);
   void DeserializeRowFilter(std::vector<Field> *values, const char *data_ptr, size_t data_len,
@@ -12,9 +12,12 @@
 #include "core/db_factory.h"
 #include "utils/utils.h"
 
+#include <atomic>
+
 #include <rocksdb/cache.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/merge_operator.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/status.h>
 #include <rocksdb/utilities/options_util.h>
 #include <rocksdb/write_batch.h>
@@ -104,17 +107,22 @@ namespace {
   const std::string PROP_FS_URI = "rocksdb.fs_uri";
   const std::string PROP_FS_URI_DEFAULT = "";
 
+  const std::string PROP_BULKLOAD_DIR = "rocksdb.bulkload_dir";
+  const std::string PROP_BULKLOAD_DIR_DEFAULT = "";
+
   static std::shared_ptr<rocksdb::Env> env_guard;
   static std::shared_ptr<rocksdb::Cache> block_cache;
 #if ROCKSDB_MAJOR < 8
   static std::shared_ptr<rocksdb::Cache> block_cache_compressed;
 #endif
+  static std::atomic<uint64_t> bulkload_file_seq{0};
 } // anonymous
 
 namespace ycsbc {
 
 std::vector<rocksdb::ColumnFamilyHandle *> RocksdbDB::cf_handles_;
 rocksdb::DB *RocksdbDB::db_ = nullptr;
+std::string RocksdbDB::bulkload_dir_;
 int RocksdbDB::ref_cnt_ = 0;
 std::mutex RocksdbDB::mu_;
 
@@ -172,6 +180,9 @@ void RocksdbDB::Init() {
     method_update_ = &RocksdbDB::UpdateSingle;
     method_insert_ = &RocksdbDB::InsertSingle;
     method_delete_ = &RocksdbDB::DeleteSingle;
+    method_multiread_ = &RocksdbDB::MultiReadSingle;
+    method_batchwrite_ = &RocksdbDB::BatchWriteSingle;
+    method_bulkload_ = &RocksdbDB::BulkLoadSingle;
 #ifdef USE_MERGEUPDATE
     if (props.GetProperty(PROP_MERGEUPDATE, PROP_MERGEUPDATE_DEFAULT) == "true") {
       method_update_ = &RocksdbDB::MergeSingle;
@@ -216,6 +227,11 @@ void RocksdbDB::Init() {
   if (!s.ok()) {
     throw utils::Exception(std::string("RocksDB Open: ") + s.ToString());
   }
+
+  bulkload_dir_ = props.GetProperty(PROP_BULKLOAD_DIR, PROP_BULKLOAD_DIR_DEFAULT);
+  if (bulkload_dir_ == "") {
+    bulkload_dir_ = db_path;
+  }
 }
 
 void RocksdbDB::Cleanup() { 
@@ -534,6 +550,102 @@ DB::Status RocksdbDB::DeleteSingle(const std::string &table, const std::string &
   return kOK;
 }
 
+DB::Status RocksdbDB::BatchWriteSingle(const std::string &table,
+                                       const std::vector<std::string> &keys,
+                                       std::vector<std::vector<Field>> &values) {
+  rocksdb::WriteBatch batch;
+  std::string data;
+  for (size_t i = 0; i < keys.size(); i++) {
+    data.clear();
+    SerializeRow(values[i], data);
+    batch.Put(keys[i], data);
+  }
+  rocksdb::WriteOptions wopt;
+  rocksdb::Status s = db_->Write(wopt, &batch);
+  if (!s.ok()) {
+    throw utils::Exception(std::string("RocksDB Write: ") + s.ToString());
+  }
+  return kOK;
+}
+
+DB::Status RocksdbDB::BulkLoadSingle(const std::string &table, const std::vector<std::string> &keys,
+                                     const std::function<void(std::vector<Field> &)> &build_values) {
+  const rocksdb::Options opt = db_->GetOptions();
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(opt), opt);
+  std::vector<std::string> files;
+  std::vector<Field> values;
+  std::string data;
+  rocksdb::Status s;
+
+  // the keys are sorted, so cutting files at the target size keeps them disjoint
+  size_t i = 0;
+  while (i < keys.size()) {
+    files.push_back(bulkload_dir_ + "/ycsb-bulkload-" + std::to_string(bulkload_file_seq++) + ".sst");
+    s = writer.Open(files.back());
+    if (!s.ok()) {
+      throw utils::Exception(std::string("RocksDB SstFileWriter Open: ") + s.ToString());
+    }
+    do {
+      build_values(values);
+      data.clear();
+      SerializeRow(values, data);
+      s = writer.Put(keys[i], data);
+      if (!s.ok()) {
+        throw utils::Exception(std::string("RocksDB SstFileWriter Put: ") + s.ToString());
+      }
+      i++;
+    } while (i < keys.size() && writer.FileSize() < opt.target_file_size_base);
+    s = writer.Finish();
+    if (!s.ok()) {
+      throw utils::Exception(std::string("RocksDB SstFileWriter Finish: ") + s.ToString());
+    }
+  }
+  if (files.empty()) {
+    return kOK;
+  }
+
+  rocksdb::IngestExternalFileOptions ifo;
+  ifo.move_files = true;
+  s = db_->IngestExternalFile(files, ifo);
+  if (!s.ok()) {
+    throw utils::Exception(std::string("RocksDB IngestExternalFile: ") + s.ToString());
+  }
+  return kOK;
+}
+
+DB::Status RocksdbDB::MultiReadSingle(const std::string &table, const std::vector<std::string> &keys,
+                                      const std::vector<std::string> *fields,
+                                      std::vector<std::vector<Field>> &result) {
+  std::vector<rocksdb::Slice> key_slices(keys.begin(), keys.end());
+  std::vector<rocksdb::PinnableSlice> values(keys.size());
+  std::vector<rocksdb::Status> statuses(keys.size());
+  db_->MultiGet(rocksdb::ReadOptions(), db_->DefaultColumnFamily(), keys.size(),
+                key_slices.data(), values.data(), statuses.data());
+
+  Status status = kOK;
+  result.resize(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    result[i].clear();
+    if (statuses[i].IsNotFound()) {
+      if (status == kOK) {
+        status = kNotFound;
+      }
+      continue;
+    } else if (!statuses[i].ok()) {
+      throw utils::Exception(std::string("RocksDB MultiGet: ") + statuses[i].ToString());
+    }
+    const char *p = values[i].data();
+    const char *lim = p + values[i].size();
+    if (fields != nullptr) {
+      DeserializeRowFilter(result[i], p, lim, *fields);
+    } else {
+      DeserializeRow(result[i], p, lim);
+      assert(result[i].size() == static_cast<size_t>(fieldcount_));
+    }
+  }
+  return status;
+}
+
 DB *NewRocksdbDB() {
   return new RocksdbDB;
 }
@@ -50,6 +50,21 @@ class RocksdbDB : public DB {
     return (this->*(method_delete_))(table, key);
   }
 
+  Status MultiRead(const std::string &table, const std::vector<std::string> &keys,
+                   const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result) {
+    return (this->*(method_multiread_))(table, keys, fields, result);
+  }
+
+  Status BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                    std::vector<std::vector<Field>> &values) {
+    return (this->*(method_batchwrite_))(table, keys, values);
+  }
+
+  Status BulkLoad(const std::string &table, const std::vector<std::string> &keys,
+                  const std::function<void(std::vector<Field> &)> &build_values) {
+    return (this->*(method_bulkload_))(table, keys, build_values);
+  }
+
  private:
   enum RocksFormat {
     kSingleRow,
@@ -78,6 +93,13 @@ class RocksdbDB : public DB {
   Status InsertSingle(const std::string &table, const std::string &key,
                       std::vector<Field> &values);
   Status DeleteSingle(const std::string &table, const std::string &key);
+  Status MultiReadSingle(const std::string &table, const std::vector<std::string> &keys,
+                         const std::vector<std::string> *fields,
+                         std::vector<std::vector<Field>> &result);
+  Status BatchWriteSingle(const std::string &table, const std::vector<std::string> &keys,
+                          std::vector<std::vector<Field>> &values);
+  Status BulkLoadSingle(const std::string &table, const std::vector<std::string> &keys,
+                        const std::function<void(std::vector<Field> &)> &build_values);
 
   Status (RocksdbDB::*method_read_)(const std::string &, const std:: string &,
                                     const std::vector<std::string> *, std::vector<Field> &);
@@ -89,11 +111,19 @@ class RocksdbDB : public DB {
   Status (RocksdbDB::*method_insert_)(const std::string &, const std::string &,
                                       std::vector<Field> &);
   Status (RocksdbDB::*method_delete_)(const std::string &, const std::string &);
+  Status (RocksdbDB::*method_multiread_)(const std::string &, const std::vector<std::string> &,
+                                         const std::vector<std::string> *,
+                                         std::vector<std::vector<Field>> &);
+  Status (RocksdbDB::*method_batchwrite_)(const std::string &, const std::vector<std::string> &,
+                                          std::vector<std::vector<Field>> &);
+  Status (RocksdbDB::*method_bulkload_)(const std::string &, const std::vector<std::string> &,
+                                        const std::function<void(std::vector<Field> &)> &);
 
   int fieldcount_;
 
   static std::vector<rocksdb::ColumnFamilyHandle *> cf_handles_;
   static rocksdb::DB *db_;
+  static std::string bulkload_dir_;
   static int ref_cnt_;
   static std::mutex mu_;
 };
@@ -44,6 +44,12 @@ static sqlite3_stmt *SQLite3Prepare(sqlite3 *db, std::string query) {
   return stmt;
 }
 
+static int SQLite3StepOnce(sqlite3_stmt *stmt) {
+  int rc = sqlite3_step(stmt);
+  sqlite3_reset(stmt);
+  return rc;
+}
+
 } // anonymous
 
 namespace ycsbc {
@@ -51,6 +57,7 @@ namespace ycsbc {
 sqlite3 *SqliteDB::db_ = nullptr;
 int SqliteDB::ref_cnt_ = 0;
 std::mutex SqliteDB::mu_;
+std::mutex SqliteDB::write_mu_;
 
 std::string SqliteDB::key_;
 std::string SqliteDB::field_prefix_;
@@ -162,6 +169,11 @@ void SqliteDB::PrepareQueries() {
 
   // Delete
   stmt_delete_ = SQLite3Prepare(db_, BuildDeleteQuery(table_name_, key_));
+
+  // BatchWrite
+  stmt_begin_ = SQLite3Prepare(db_, "BEGIN");
+  stmt_commit_ = SQLite3Prepare(db_, "COMMIT");
+  stmt_rollback_ = SQLite3Prepare(db_, "ROLLBACK");
 }
 
 void SqliteDB::Cleanup() {
@@ -181,6 +193,9 @@ void SqliteDB::Cleanup() {
   }
   sqlite3_finalize(stmt_insert_);
   sqlite3_finalize(stmt_delete_);
+  sqlite3_finalize(stmt_begin_);
+  sqlite3_finalize(stmt_commit_);
+  sqlite3_finalize(stmt_rollback_);
 
   if (--ref_cnt_ == 0) {
     int rc = sqlite3_close(db_);
@@ -297,6 +312,7 @@ cleanup:
 }
 
 DB::Status SqliteDB::Update(const std::string &table, const std::string &key, std::vector<Field> &values) {
+  const std::lock_guard<std::mutex> lock(write_mu_);
   DB::Status s = kOK;
   bool temp = false;
   sqlite3_stmt *stmt;
@@ -352,6 +368,11 @@ cleanup:
 
 
 DB::Status SqliteDB::Insert(const std::string &table, const std::string &key, std::vector<Field> &values) {
+  const std::lock_guard<std::mutex> lock(write_mu_);
+  return InsertRow(key, values);
+}
+
+DB::Status SqliteDB::InsertRow(const std::string &key, std::vector<Field> &values) {
   DB::Status s = kOK;
   sqlite3_stmt *stmt = stmt_insert_;
 
@@ -386,6 +407,7 @@ cleanup:
 }
 
 DB::Status SqliteDB::Delete(const std::string &table, const std::string &key) {
+  const std::lock_guard<std::mutex> lock(write_mu_);
   DB::Status s = kOK;
   sqlite3_stmt *stmt = stmt_delete_;
 
@@ -408,6 +430,28 @@ cleanup:
   return s;
 }
 
+DB::Status SqliteDB::BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                                std::vector<std::vector<Field>> &values) {
+  // all threads share one connection and with it the transaction, so no other
+  // write may run until the batch commits or rolls back
+  const std::lock_guard<std::mutex> lock(write_mu_);
+
+  if (SQLite3StepOnce(stmt_begin_) != SQLITE_DONE) {
+    return kError;
+  }
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (InsertRow(keys[i], values[i]) != kOK) {
+      SQLite3StepOnce(stmt_rollback_);
+      return kError;
+    }
+  }
+  if (SQLite3StepOnce(stmt_commit_) != SQLITE_DONE) {
+    SQLite3StepOnce(stmt_rollback_);
+    return kError;
+  }
+  return kOK;
+}
+
 DB *NewSqliteDB() {
   return new SqliteDB;
 }
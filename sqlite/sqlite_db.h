@@ -38,14 +38,21 @@ class SqliteDB : public DB {
 
   Status Delete(const std::string &table, const std::string &key);
 
+  Status BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                    std::vector<std::vector<Field>> &values);
+
  private:
   void OpenDB();
   void SetPragma();
   void PrepareQueries();
+  Status InsertRow(const std::string &key, std::vector<Field> &values);
 
   static sqlite3 *db_;
   static int ref_cnt_;
   static std::mutex mu_;
+  // held by every write on the shared connection, for a batch throughout its
+  // transaction, so a rollback never takes other threads' writes with it
+  static std::mutex write_mu_;
 
   static std::string key_;
   static std::string field_prefix_;
@@ -57,6 +64,9 @@ class SqliteDB : public DB {
   sqlite3_stmt *stmt_update_all_;
   sqlite3_stmt *stmt_insert_;
   sqlite3_stmt *stmt_delete_;
+  sqlite3_stmt *stmt_begin_;
+  sqlite3_stmt *stmt_commit_;
+  sqlite3_stmt *stmt_rollback_;
   std::unordered_map<std::string, sqlite3_stmt *> stmt_read_field_;
   std::unordered_map<std::string, sqlite3_stmt *> stmt_scan_field_;
   std::unordered_map<std::string, sqlite3_stmt *> stmt_update_field_;
@@ -28,6 +28,8 @@ class Properties {
   void SetProperty(const std::string &key, const std::string &value);
   bool ContainsKey(const std::string &key) const;
   void Load(std::ifstream &input);
+  std::map<std::string, std::string>::const_iterator begin() const { return properties_.begin(); }
+  std::map<std::string, std::string>::const_iterator end() const { return properties_.end(); }
  private:
   std::map<std::string, std::string> properties_;
 };
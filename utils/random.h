@@ -0,0 +1,145 @@
+//
+//  random.h
+//  YCSB-cpp
+//
+//  Fast per-thread pseudo random numbers shared by all generators.
+//
+
+#ifndef YCSB_C_RANDOM_H_
+#define YCSB_C_RANDOM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace ycsbc {
+
+namespace utils {
+
+///
+/// xoshiro256** generator, seeded through splitmix64.
+/// It meets UniformRandomBitGenerator, so it can drive the std distributions too.
+///
+class Xoshiro256 {
+ public:
+  using result_type = uint64_t;
+
+  explicit Xoshiro256(uint64_t seed = 0) { Seed(seed); }
+
+  void Seed(uint64_t seed) {
+    for (uint64_t &s : s_) {
+      seed += 0x9E3779B97F4A7C15ull;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+      s = z ^ (z >> 31);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT64_MAX; }
+  result_type operator()() { return Next(); }
+
+  uint64_t Next() {
+    const uint64_t result = Rotl(s_[1] * 5, 7) * 9;
+    const uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = Rotl(s_[3], 45);
+    return result;
+  }
+
+  ///
+  /// Returns a double uniformly distributed in [0, 1).
+  ///
+  double NextDouble() {
+    return (Next() >> 11) * 0x1.0p-53;
+  }
+
+  ///
+  /// Returns an integer uniformly distributed in [0, n), n > 0.
+  /// Uses a multiply-shift instead of a division; the bias is below n / 2^64.
+  ///
+  uint64_t NextBelow(uint64_t n) {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(Next()) * n) >> 64);
+#else
+    return Next() % n;
+#endif
+  }
+
+  ///
+  /// Fills out with n random values, keeping the state in registers meanwhile.
+  ///
+  void Fill(uint64_t *out, size_t n) {
+    Xoshiro256 local = *this;
+    for (size_t i = 0; i < n; i++) {
+      out[i] = local.Next();
+    }
+    *this = local;
+  }
+
+  void FillDouble(double *out, size_t n) {
+    Xoshiro256 local = *this;
+    for (size_t i = 0; i < n; i++) {
+      out[i] = local.NextDouble();
+    }
+    *this = local;
+  }
+
+ private:
+  static uint64_t Rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  uint64_t s_[4];
+};
+
+namespace internal {
+
+inline std::atomic<uint64_t> random_seed{std::random_device{}() * 0x100000001ull ^ std::random_device{}()};
+inline std::atomic<uint64_t> random_thread_count{0};
+
+inline uint64_t StreamSeed(uint64_t stream) {
+  return random_seed.load() ^ (stream * 0xD1B54A32D192ED03ull);
+}
+
+} // internal
+
+///
+/// Sets the seed of the per-thread generators created afterwards.
+/// Each thread mixes it with its own index, so threads draw independent streams.
+///
+inline void SetRandomSeed(uint64_t seed) {
+  internal::random_seed = seed;
+}
+
+///
+/// Returns the generator of the calling thread, created on first use.
+/// Threads are numbered in the order of their first draw, unless they pick
+/// their stream with SetThreadRandomStream.
+///
+inline Xoshiro256 &ThreadLocalRng() {
+  static thread_local Xoshiro256 rng(internal::StreamSeed(internal::random_thread_count++));
+  return rng;
+}
+
+///
+/// Restarts the generator of the calling thread on the given stream of the
+/// current seed. Threads that need reproducible draws, like the client
+/// threads, call this with a fixed index before drawing.
+///
+inline void SetThreadRandomStream(uint64_t stream) {
+  // explicit streams are kept apart from the ones numbered by first draw
+  ThreadLocalRng().Seed(internal::StreamSeed(~stream));
+}
+
+} // utils
+
+} // ycsbc
+
+#endif // YCSB_C_RANDOM_H_
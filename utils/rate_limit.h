@@ -19,58 +19,86 @@ namespace ycsbc {
 
 namespace utils {
 
-// Token bucket rate limiter for single client
+// Rate limiter for single client
+// By default a token bucket holding up to b tokens, so a client that stalled
+// bursts at most b operations before it is back to the rate. With open_loop,
+// operations are instead scheduled on a fixed-rate timeline that keeps the
+// time lost in a stall: a client behind it issues right away until it has
+// caught up, so the stall delays the operations but never drops them. A
+// change of rate restarts the timeline, so a backlog is not paid back at
+// another rate.
 class RateLimiter {
  public:
-  RateLimiter(int64_t r, int64_t b) : r_(r * TOKEN_PRECISION), b_(b * TOKEN_PRECISION), tokens_(0), last_(Clock::now()) {}
+  using Clock = std::chrono::steady_clock;
+
+  RateLimiter(int64_t r, int64_t b, bool open_loop)
+      : r_(r * TOKEN_PRECISION), b_(b * TOKEN_PRECISION), tokens_(0), last_(Clock::now()),
+        open_loop_(open_loop), scheduled_(false) {}
 
-  inline void Consume(int64_t n) {
+  // Returns the time the consumed operations were scheduled to start at,
+  // after sleeping until then, or until deadline if that comes first.
+  inline Clock::time_point Consume(int64_t n, Clock::time_point deadline = Clock::time_point::max()) {
     std::unique_lock<std::mutex> lock(mutex_);
 
+    auto now = Clock::now();
     if (r_ <= 0) {
-      return;
+      return now;
     }
 
-    // refill tokens
-    auto now = Clock::now();
-    auto diff = std::chrono::duration_cast<Duration>(now - last_);
-    tokens_ = std::min(b_, tokens_ + diff.count() * r_ / 1000000000);
-    last_ = now;
-
-    // check tokens
-    tokens_ -= n * TOKEN_PRECISION;
+    Clock::time_point intended;
+    if (open_loop_) {
+      // advance schedule, starting at the first limited call
+      if (!scheduled_) {
+        schedule_ = now;
+        scheduled_ = true;
+      }
+      schedule_ += Duration(n * TOKEN_PRECISION * 1000000000 / r_);
+      intended = schedule_;
+    } else {
+      // refill and check tokens
+      Refill(now);
+      tokens_ -= n * TOKEN_PRECISION;
+      intended = now + Duration(std::max<int64_t>(0, -tokens_) * 1000000000 / r_);
+    }
+    lock.unlock();
 
-    // sleep
-    if (tokens_ < 0) {
-      lock.unlock();
-      int64_t wait_time = -tokens_ * 1000000000 / r_;
-      std::this_thread::sleep_for(std::chrono::nanoseconds(wait_time));
+    // sleep, unless behind schedule
+    if (intended > now) {
+      std::this_thread::sleep_until(std::min(intended, deadline));
     }
+    return intended;
   }
 
   inline void SetRate(int64_t r) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    // refill tokens
-    auto now = Clock::now();
-    auto diff = std::chrono::duration_cast<Duration>(now - last_);
-    tokens_ = std::min(b_, tokens_ + diff.count() * r_ * TOKEN_PRECISION / 1000000000);
-    last_ = now;
+    Refill(Clock::now());
 
-    // set rate
+    // set rate, restarting the schedule when it changes
+    if (r * TOKEN_PRECISION != r_) {
+      scheduled_ = false;
+    }
     r_ = r * TOKEN_PRECISION;
   }
 
  private:
-  using Clock = std::chrono::steady_clock;
   using Duration = std::chrono::nanoseconds;
   static constexpr int64_t TOKEN_PRECISION = 10000;
 
+  inline void Refill(Clock::time_point now) {
+    auto diff = std::chrono::duration_cast<Duration>(now - last_);
+    tokens_ = std::min(b_, tokens_ + diff.count() * r_ / 1000000000);
+    last_ = now;
+  }
+
   std::mutex mutex_;
   int64_t r_;
   int64_t b_;
   int64_t tokens_;
   Clock::time_point last_;
+  const bool open_loop_;
+  bool scheduled_;
+  Clock::time_point schedule_;
 };
 
 } // utils
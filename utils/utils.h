@@ -16,6 +16,8 @@
 #include <random>
 #include <locale>
 
+#include "random.h"
+
 #if defined(_MSC_VER)
 #if _MSC_VER >= 1911
 #define MAYBE_UNUSED [[maybe_unused]]
@@ -49,23 +51,18 @@ inline uint64_t FNVHash64(uint64_t val) {
 inline uint64_t Hash(uint64_t val) { return FNVHash64(val); }
 
 inline uint32_t ThreadLocalRandomInt() {
-  static thread_local std::random_device rd;
-  static thread_local std::minstd_rand rn(rd());
-  return rn();
+  return static_cast<uint32_t>(ThreadLocalRng().Next() >> 32);
 }
 
 inline double ThreadLocalRandomDouble(double min = 0.0, double max = 1.0) {
-  static thread_local std::random_device rd;
-  static thread_local std::minstd_rand rn(rd());
-  static thread_local std::uniform_real_distribution<double> uniform(min, max);
-  return uniform(rn);
+  return min + (max - min) * ThreadLocalRng().NextDouble();
 }
 
 ///
 /// Returns an ASCII code that can be printed to desplay
 ///
 inline char RandomPrintChar() {
-  return rand() % 94 + 33;
+  return ThreadLocalRng().NextBelow(94) + 33;
 }
 
 class Exception : public std::exception {
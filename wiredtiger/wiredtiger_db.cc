@@ -102,6 +102,7 @@ void WTDB::Init(){
     method_update_ = &WTDB::UpdateSingleEntry;
     method_insert_ = &WTDB::InsertSingleEntry;
     method_delete_ = &WTDB::DeleteSingleEntry;
+    method_batchwrite_ = &WTDB::BatchWriteSingleEntry;
   } else {
     throw utils::Exception("single ONLY");
   }
@@ -312,6 +313,30 @@ DB::Status WTDB::DeleteSingleEntry(const std::string &table, const std::string &
   error_check(cursor_->remove(cursor_));
   return kOK;
 }
+DB::Status WTDB::BatchWriteSingleEntry(const std::string &table,
+                                       const std::vector<std::string> &keys,
+                                       std::vector<std::vector<Field>> &values){
+  std::string data;
+  WT_ITEM k, v;
+
+  error_check(session_->begin_transaction(session_, NULL));
+  for (size_t i = 0; i < keys.size(); i++) {
+    k.data = keys[i].data();
+    k.size = keys[i].size();
+    cursor_->set_key(cursor_, &k);
+    data.clear();
+    SerializeRow(values[i], &data);
+    v.data = data.data();
+    v.size = data.size();
+    cursor_->set_value(cursor_, &v);
+    if (cursor_->insert(cursor_) != 0) {
+      session_->rollback_transaction(session_, NULL);
+      throw utils::Exception("[" WT_PREFIX "] BatchWrite insert");
+    }
+  }
+  error_check(session_->commit_transaction(session_, NULL));
+  return kOK;
+}
 
 void WTDB::SerializeRow(const std::vector<Field> &values, std::string *data) {
   for (const Field &field : values) {
@@ -46,6 +46,11 @@ class WTDB : public DB {
     return (this->*(method_delete_))(table, key);
   }
 
+  Status BatchWrite(const std::string &table, const std::vector<std::string> &keys,
+                    std::vector<std::vector<Field>> &values) {
+    return (this->*(method_batchwrite_))(table, keys, values);
+  }
+
  private:
 
   Status ReadSingleEntry(const std::string &table, const std::string &key,
@@ -58,6 +63,8 @@ class WTDB : public DB {
   Status InsertSingleEntry(const std::string &table, const std::string &key,
                            std::vector<Field> &values);
   Status DeleteSingleEntry(const std::string &table, const std::string &key);
+  Status BatchWriteSingleEntry(const std::string &table, const std::vector<std::string> &keys,
+                               std::vector<std::vector<Field>> &values);
 
   void SerializeRow(const std::vector<Field> &values, std::string *data);
   void DeserializeRow(std::vector<Field> *values, const char *data_ptr, size_t data_len);
@@ -73,6 +80,8 @@ class WTDB : public DB {
   Status (WTDB::*method_insert_)(const std::string &, const std::string &,
                                       std::vector<Field> &);
   Status (WTDB::*method_delete_)(const std::string &, const std::string &);
+  Status (WTDB::*method_batchwrite_)(const std::string &, const std::vector<std::string> &,
+                                     std::vector<std::vector<Field>> &);
   
   unsigned fieldcount_;
 